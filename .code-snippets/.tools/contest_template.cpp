@@ -1,5 +1,19 @@
 #include <bits/stdc++.h>
 
+// SSE2 / AVX2 intrinsics for the SIMD snippets (MultiRangeHash, FlatHashMap, Kmp), which cannot include it themselves
+// from inside their namespaces.
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// POSIX headers for MappedFile, which is only defined where they exist.
+#if __has_include(<sys/mman.h>)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 using int8 = signed char;
 using int16 = short;
 using int32 = int;
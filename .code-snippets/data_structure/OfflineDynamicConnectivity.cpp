@@ -0,0 +1,247 @@
+/**
+ * @brief Segment tree over time + rollback state.
+ *
+ * @c _State needs @c checkpoint() and @c rollback(cp), e.g. DisjointSet [with undo].
+ * @c apply(state, item) may return @c false to prune the whole subtree (e.g. a bipartite contradiction),
+ * in which case no query inside it is reported.
+ */
+template<typename _Tp = std::pair<int, int>>
+class OfflineDynamicConnectivity
+{
+public:
+
+    using size_type = int;
+    using value_type = _Tp;
+
+    struct unite_edge
+    {
+        template<typename _State>
+        constexpr bool
+        operator()(_State& __state, const value_type& __e) const
+        { return __state.unite(__e.first, __e.second), true; }
+    };
+
+    OfflineDynamicConnectivity() = default;
+
+    /**
+     * @returns handle for remove()
+     */
+    size_type
+    add(const value_type& __item)
+    {
+        _M_items.push_back(__item);
+        _M_begin.push_back(_M_time);
+
+        return static_cast<size_type>(_M_items.size()) - 1;
+    }
+
+    /**
+     * @note Removing a handle that is not alive (already removed, or from add_interval()) does nothing.
+     */
+    void
+    remove(size_type __handle)
+    {
+        if (_M_begin[__handle] != npos and _M_begin[__handle] < _M_time)
+        {
+            _M_intervals.emplace_back(_M_begin[__handle], _M_time - 1, __handle);
+        }
+
+        _M_begin[__handle] = npos;
+    }
+
+    /**
+     * @brief Makes @p __item alive for queries [l, r].
+     *
+     * @note The interval may reach past the queries made so far; run() clips it to [0, queries()).
+     */
+    void
+    add_interval(size_type __l, size_type __r, const value_type& __item)
+    {
+        _M_items.push_back(__item);
+        _M_begin.push_back(npos);
+
+        if (__l <= __r)
+        {
+            _M_intervals.emplace_back(__l, __r, static_cast<size_type>(_M_items.size()) - 1);
+        }
+    }
+
+    /**
+     * @returns index of the query, passed back to @c on_query in run()
+     */
+    size_type
+    query()
+    { return _M_time++; }
+
+    [[nodiscard]] size_type
+    queries() const noexcept
+    { return _M_time; }
+
+    template<typename _State, typename _Apply = unite_edge, typename _OnQuery>
+    void
+    run(_State& __state, _OnQuery __on_query, _Apply __apply = {})
+    {
+        if (_M_time == 0)
+        {
+            return;
+        }
+
+        _M_build();
+
+        using checkpoint_type = decltype(__state.checkpoint());
+
+        // ~u marks leaving node u
+        std::vector<std::pair<size_type, checkpoint_type>> stk;
+        stk.reserve(std::bit_width(static_cast<unsigned>(_M_leaves)) * 2 + 2);
+        stk.emplace_back(1, checkpoint_type{});
+
+        const int height = std::bit_width(static_cast<unsigned>(_M_leaves)) - 1;
+
+        while (not stk.empty())
+        {
+            const auto [u, cp] = stk.back();
+            stk.pop_back();
+
+            if (u < 0)
+            {
+                __state.rollback(cp);
+                continue;
+            }
+
+            if (const int depth = std::bit_width(static_cast<unsigned>(u)) - 1;
+                ((u << (height - depth)) - _M_leaves) >= _M_time)
+            {
+                continue;
+            }
+
+            const checkpoint_type c = __state.checkpoint();
+            bool alive = true;
+
+            for (size_type i = _M_start[u]; i < _M_start[u + 1]; ++i)
+            {
+                if (not _S_apply(__apply, __state, _M_items[_M_list[i]]))
+                {
+                    alive = false;
+                    break;
+                }
+            }
+
+            if (alive)
+            {
+                if (u >= _M_leaves)
+                {
+                    __on_query(std::as_const(__state), u - _M_leaves);
+                }
+                else
+                {
+                    stk.emplace_back(~u, c);
+                    stk.emplace_back(u << 1 | 1, checkpoint_type{});
+                    stk.emplace_back(u << 1, checkpoint_type{});
+                    continue;
+                }
+            }
+
+            __state.rollback(c);
+        }
+    }
+
+    void
+    clear()
+    {
+        _M_items.clear();
+        _M_begin.clear();
+        _M_intervals.clear();
+        _M_time = 0;
+    }
+
+private:
+
+    static constexpr size_type npos = -1;
+
+    template<typename _Apply, typename _State>
+    static bool
+    _S_apply(_Apply& __apply, _State& __state, const value_type& __item)
+    {
+        if constexpr (std::is_void_v<std::invoke_result_t<_Apply&, _State&, const value_type&>>)
+        {
+            return std::invoke(__apply, __state, __item), true;
+        }
+        else
+        {
+            return static_cast<bool>(std::invoke(__apply, __state, __item));
+        }
+    }
+
+    template<typename _Callback>
+    void
+    _M_for_each_node(size_type __l, size_type __r, _Callback __func) const
+    {
+        for (__l += _M_leaves, __r += _M_leaves + 1; __l < __r; __l >>= 1, __r >>= 1)
+        {
+            if (__l & 1)
+            {
+                __func(__l++);
+            }
+
+            if (__r & 1)
+            {
+                __func(--__r);
+            }
+        }
+    }
+
+    void
+    _M_build()
+    {
+        _M_leaves = static_cast<size_type>(std::bit_ceil(static_cast<unsigned>(_M_time)));
+
+        std::vector<std::tuple<size_type, size_type, size_type>> intervals = _M_intervals;
+
+        for (size_type i = 0; i < static_cast<size_type>(_M_items.size()); ++i)
+        {
+            if (_M_begin[i] != npos and _M_begin[i] < _M_time)
+            {
+                intervals.emplace_back(_M_begin[i], _M_time - 1, i);
+            }
+        }
+
+        _M_start.assign(_M_leaves * 2 + 1, 0);
+
+        // add_interval() may reach outside [0, _M_time), which would index past the leaves.
+        std::erase_if(intervals, [this](auto& t) -> bool
+        {
+            auto& [l, r, id] = t;
+            l = std::max(l, 0);
+            r = std::min(r, _M_time - 1);
+            return l > r;
+        });
+
+        for (const auto& [l, r, id] : intervals)
+        {
+            _M_for_each_node(l, r, [&](size_type u) -> void { ++_M_start[u + 1]; });
+        }
+
+        std::partial_sum(_M_start.begin(), _M_start.end(), _M_start.begin());
+
+        _M_list.resize(_M_start.back());
+
+        std::vector<size_type> pos(_M_start.begin(), _M_start.end() - 1);
+
+        for (const auto& [l, r, id] : intervals)
+        {
+            _M_for_each_node(l, r, [&](size_type u) -> void { _M_list[pos[u]++] = id; });
+        }
+    }
+
+    std::vector<value_type> _M_items;
+    std::vector<size_type> _M_begin;
+
+    std::vector<std::tuple<size_type, size_type, size_type>> _M_intervals;
+
+    size_type _M_time = 0;
+    size_type _M_leaves = 0;
+
+    // CSR: items of node u are _M_list[_M_start[u], _M_start[u + 1])
+    std::vector<size_type> _M_start;
+    std::vector<size_type> _M_list;
+};
\ No newline at end of file
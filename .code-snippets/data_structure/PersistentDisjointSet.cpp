@@ -0,0 +1,182 @@
+class PersistentDisjointSet
+{
+public:
+
+    using size_type = int;
+
+    struct node
+    {
+        size_type left;
+        size_type right;
+
+        size_type parent;
+        size_type size;
+    };
+
+    explicit
+    PersistentDisjointSet(size_type __n)
+        : _M_n(__n)
+    { reset(); }
+
+    /**
+     * @returns root of @p u in @p __version, O(log² n)
+     */
+    [[nodiscard]] size_type
+    find(size_type __version, size_type u) const
+    {
+        const size_type root = _M_roots[__version];
+
+        for (size_type p; (p = _M_leaf(root, u).parent) != u; u = p);
+
+        return u;
+    }
+
+    /**
+     * @returns new version, equal in content to @p __version if @p u and @p v were already connected
+     */
+    size_type
+    unite(size_type __version, size_type u, size_type v)
+    {
+        size_type fu = find(__version, u);
+        size_type fv = find(__version, v);
+
+        size_type root = _M_roots[__version];
+
+        if (fu != fv)
+        {
+            size_type su = _M_leaf(root, fu).size;
+            size_type sv = _M_leaf(root, fv).size;
+
+            if (su < sv)
+            {
+                std::swap(fu, fv);
+                std::swap(su, sv);
+            }
+
+            root = _M_update(root, 0, _M_n - 1, fv, fu, sv);
+            root = _M_update(root, 0, _M_n - 1, fu, fu, su + sv);
+        }
+
+        _M_roots.push_back(root);
+        return versions() - 1;
+    }
+
+    [[nodiscard]] bool
+    connected(size_type __version, size_type u, size_type v) const
+    { return find(__version, u) == find(__version, v); }
+
+    [[nodiscard]] size_type
+    component_size(size_type __version, size_type u) const
+    { return _M_leaf(_M_roots[__version], find(__version, u)).size; }
+
+    /**
+     * @brief Makes a new version identical to @p __version.
+     */
+    size_type
+    clone(size_type __version)
+    {
+        _M_roots.push_back(_M_roots[__version]);
+        return versions() - 1;
+    }
+
+    [[nodiscard]] size_type
+    versions() const noexcept
+    { return static_cast<size_type>(_M_roots.size()); }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return _M_n; }
+
+    void
+    reserve(size_type __unions)
+    { _M_arena.reserve(_M_arena.size() + static_cast<std::size_t>(__unions) * 2 * (std::bit_width(static_cast<unsigned>(_M_n)) + 1)); }
+
+    /**
+     * @brief Drops all versions except the initial one (version 0).
+     */
+    void
+    reset()
+    {
+        _M_arena.clear();
+        _M_roots.clear();
+
+        _M_arena.reserve(static_cast<std::size_t>(std::max(_M_n, 1)) * 2);
+        _M_roots.push_back(_M_n ? _M_build(0, _M_n - 1) : size_type{});
+    }
+
+private:
+
+    [[nodiscard]] const node&
+    _M_leaf(size_type __root, size_type __pos) const
+    {
+        size_type l = 0, r = _M_n - 1;
+
+        while (l != r)
+        {
+            const size_type mid = (l + r) >> 1;
+
+            if (__pos <= mid)
+            {
+                __root = _M_arena[__root].left;
+                r = mid;
+            }
+            else
+            {
+                __root = _M_arena[__root].right;
+                l = mid + 1;
+            }
+        }
+
+        return _M_arena[__root];
+    }
+
+    size_type
+    _M_build(size_type __l, size_type __r)
+    {
+        const size_type u = static_cast<size_type>(_M_arena.size());
+        _M_arena.push_back(node{0, 0, __l, 1});
+
+        if (__l != __r)
+        {
+            const size_type mid = (__l + __r) >> 1;
+
+            const size_type lc = _M_build(__l, mid);
+            const size_type rc = _M_build(mid + 1, __r);
+
+            _M_arena[u].left = lc;
+            _M_arena[u].right = rc;
+        }
+
+        return u;
+    }
+
+    size_type
+    _M_update(size_type __u, size_type __l, size_type __r, size_type __pos, size_type __parent, size_type __size)
+    {
+        const size_type v = static_cast<size_type>(_M_arena.size());
+        _M_arena.push_back(_M_arena[__u]);
+
+        if (__l == __r)
+        {
+            _M_arena[v].parent = __parent;
+            _M_arena[v].size = __size;
+        }
+        else if (const size_type mid = (__l + __r) >> 1; __pos <= mid)
+        {
+            const size_type lc = _M_update(_M_arena[__u].left, __l, mid, __pos, __parent, __size);
+            _M_arena[v].left = lc;
+        }
+        else
+        {
+            const size_type rc = _M_update(_M_arena[__u].right, mid + 1, __r, __pos, __parent, __size);
+            _M_arena[v].right = rc;
+        }
+
+        return v;
+    }
+
+    size_type _M_n;
+
+    std::vector<node> _M_arena;
+    std::vector<size_type> _M_roots;
+};
\ No newline at end of file
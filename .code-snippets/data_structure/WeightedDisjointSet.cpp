@@ -0,0 +1,206 @@
+struct PotentialGroup
+{
+    template<typename _Tp = int>
+    struct Xor
+    {
+        using value_type = _Tp;
+
+        [[nodiscard]] static constexpr value_type
+        identity() noexcept
+        { return value_type{}; }
+
+        [[nodiscard]] static constexpr value_type
+        op(const value_type& __a, const value_type& __b) noexcept
+        { return __a ^ __b; }
+
+        [[nodiscard]] static constexpr value_type
+        inverse(const value_type& __a) noexcept
+        { return __a; }
+    };
+
+    template<typename _Tp = long long>
+    struct Add
+    {
+        using value_type = _Tp;
+
+        [[nodiscard]] static constexpr value_type
+        identity() noexcept
+        { return value_type{}; }
+
+        [[nodiscard]] static constexpr value_type
+        op(const value_type& __a, const value_type& __b) noexcept
+        { return __a + __b; }
+
+        [[nodiscard]] static constexpr value_type
+        inverse(const value_type& __a) noexcept
+        { return -__a; }
+    };
+
+    template<typename _Tp, _Tp _Modulus>
+    struct AddMod
+    {
+        using value_type = _Tp;
+
+        [[nodiscard]] static constexpr value_type
+        identity() noexcept
+        { return value_type{}; }
+
+        [[nodiscard]] static constexpr value_type
+        op(const value_type& __a, const value_type& __b) noexcept
+        { return (__a + __b) % _Modulus; }
+
+        [[nodiscard]] static constexpr value_type
+        inverse(const value_type& __a) noexcept
+        { return (_Modulus - __a % _Modulus) % _Modulus; }
+    };
+};
+
+/**
+ * @brief Maintains value(u) - value(find(u)) under an abelian @p _Group.
+ */
+template<typename _Group = PotentialGroup::Add<>>
+requires requires(const typename _Group::value_type& __a) {
+    { _Group::identity() } -> std::convertible_to<typename _Group::value_type>;
+    { _Group::op(__a, __a) } -> std::convertible_to<typename _Group::value_type>;
+    { _Group::inverse(__a) } -> std::convertible_to<typename _Group::value_type>; }
+class WeightedDisjointSet
+{
+public:
+
+    using size_type = int;
+    using group_type = _Group;
+    using value_type = typename _Group::value_type;
+
+    struct node
+    {
+        size_type parent;
+        size_type size;
+
+        value_type potential;
+    };
+
+    enum unite_result
+    {
+        merged,
+        redundant,
+        contradiction
+    };
+
+    explicit
+    WeightedDisjointSet(size_type __n)
+        : _M_tree(__n)
+    { reset(); }
+
+    [[nodiscard]] size_type
+    find(size_type u)
+    {
+        if (is_root(u))
+        {
+            return u;
+        }
+
+        const size_type p = _M_tree[u].parent;
+        const size_type root = find(p);
+
+        _M_tree[u].potential = _Group::op(_M_tree[u].potential, _M_tree[p].potential);
+        _M_tree[u].parent = root;
+
+        return root;
+    }
+
+    /**
+     * @returns value(u) - value(find(u))
+     */
+    [[nodiscard]] value_type
+    potential(size_type u)
+    { return find(u), _M_tree[u].potential; }
+
+    /**
+     * @brief Records value(v) - value(u) = w.
+     */
+    unite_result
+    unite(size_type u, size_type v, value_type w)
+    {
+        size_type fu = find(u);
+        size_type fv = find(v);
+
+        if (fu == fv)
+        {
+            return _Group::op(_M_tree[v].potential, _Group::inverse(_M_tree[u].potential)) == w ? redundant : contradiction;
+        }
+
+        // value(fv) - value(fu)
+        w = _Group::op(_Group::op(w, _M_tree[u].potential), _Group::inverse(_M_tree[v].potential));
+
+        if (_M_tree[fu].size < _M_tree[fv].size)
+        {
+            std::swap(fu, fv);
+            w = _Group::inverse(w);
+        }
+
+        _M_tree[fv].parent = fu;
+        _M_tree[fv].potential = w;
+        _M_tree[fu].size += _M_tree[fv].size;
+
+        return merged;
+    }
+
+    /**
+     * @returns value(v) - value(u), or std::nullopt if @p u and @p v are not connected.
+     */
+    [[nodiscard]] std::optional<value_type>
+    diff(size_type u, size_type v)
+    {
+        if (find(u) != find(v))
+        {
+            return std::nullopt;
+        }
+
+        return _Group::op(_M_tree[v].potential, _Group::inverse(_M_tree[u].potential));
+    }
+
+    [[nodiscard]] bool
+    is_root(size_type u) const
+    { return _M_tree[u].parent == u; }
+
+    [[nodiscard]] bool
+    connected(size_type u, size_type v)
+    { return find(u) == find(v); }
+
+    void
+    expand(size_type __n)
+    {
+        const size_type old_size = size();
+        _M_tree.resize(old_size + __n);
+
+        for (size_type i = old_size; i < old_size + __n; ++i)
+        {
+            _M_tree[i].parent = i;
+            _M_tree[i].size = 1;
+            _M_tree[i].potential = _Group::identity();
+        }
+    }
+
+    void
+    reset()
+    {
+        for (size_type i = 0; i < size(); ++i)
+        {
+            _M_tree[i].parent = i;
+            _M_tree[i].size = 1;
+            _M_tree[i].potential = _Group::identity();
+        }
+    }
+
+    [[nodiscard]] size_type
+    size() const
+    { return static_cast<size_type>(_M_tree.size()); }
+
+    [[nodiscard]] size_type
+    component_size(size_type u)
+    { return _M_tree[find(u)].size; }
+
+private:
+
+    std::vector<node> _M_tree;
+};
\ No newline at end of file
@@ -0,0 +1,630 @@
+/**
+ * @brief Open addressing hash table with SwissTable-style control bytes, keyed by the Hash<> functors.
+ *
+ * Slots live in one flat array next to one control byte each: empty, deleted (tombstone), or the top 7 bits of the
+ * key's mixed hash. A probe loads 16 control bytes at once and only touches slots whose byte matches, so a lookup is
+ * usually one group of control bytes plus one slot. Groups are probed triangularly, which visits every group once.
+ *
+ * Hash<integral> is seeded at startup, so the table keeps its resistance to anti-hash tests.
+ *
+ * The other Hash<> functors return values below hash_mod, at most 32 bits, so the functor's result is mixed once
+ * before it is split into the group index (low bits) and the control byte (top 7 bits).
+ *
+ * @tparam _Tp mapped type, @c void for a set
+ * @note Like std::vector, insertion may move elements and invalidates iterators and references.
+ * @note The SSE2 group scan needs <immintrin.h> from the contest template prelude.
+ */
+template<typename _Key, typename _Tp, typename _Hash = Hash<_Key>, typename _KeyEqual = std::equal_to<_Key>>
+class FlatHashTable
+{
+public:
+
+    using key_type = _Key;
+    using mapped_type = _Tp;
+
+private:
+
+    template<typename _Up>
+    struct _S_value
+    { using type = std::pair<const _Key, _Up>; };
+
+    template<typename _Up>
+    requires std::is_void_v<_Up>
+    struct _S_value<_Up>
+    { using type = _Key; };
+
+public:
+
+    // Set elements are only reachable through const iterators.
+    using value_type = typename _S_value<_Tp>::type;
+    using hasher = _Hash;
+    using key_equal = _KeyEqual;
+    using size_type = std::size_t;
+
+    static constexpr bool is_map = not std::is_void_v<_Tp>;
+
+private:
+
+    using ctrl_type = int8;
+
+    static constexpr ctrl_type _S_empty = -128;
+    static constexpr ctrl_type _S_deleted = -2;
+
+    static constexpr size_type _S_group_width = 16;
+
+public:
+
+    template<bool _Const>
+    class basic_iterator
+    {
+    public:
+
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashTable::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<_Const, const value_type*, value_type*>;
+        using reference = std::conditional_t<_Const, const value_type&, value_type&>;
+
+        basic_iterator() noexcept = default;
+
+        basic_iterator(const ctrl_type* __ctrl, const ctrl_type* __last, value_type* __slot) noexcept
+            : _M_ctrl(__ctrl), _M_last(__last), _M_slot(__slot)
+        { _M_skip(); }
+
+        operator basic_iterator<true>() const noexcept
+        requires (not _Const)
+        { return {_M_ctrl, _M_last, _M_slot}; }
+
+        [[nodiscard]] reference
+        operator*() const noexcept
+        { return *_M_slot; }
+
+        [[nodiscard]] pointer
+        operator->() const noexcept
+        { return _M_slot; }
+
+        basic_iterator&
+        operator++() noexcept
+        {
+            ++_M_ctrl;
+            ++_M_slot;
+
+            _M_skip();
+            return *this;
+        }
+
+        basic_iterator
+        operator++(int) noexcept
+        {
+            basic_iterator tmp = *this;
+            ++*this;
+            return tmp;
+        }
+
+        [[nodiscard]] friend bool
+        operator==(const basic_iterator& __lhs, const basic_iterator& __rhs) noexcept
+        { return __lhs._M_ctrl == __rhs._M_ctrl; }
+
+    private:
+
+        friend class FlatHashTable;
+
+        void
+        _M_skip() noexcept
+        {
+            for (; _M_ctrl != _M_last and *_M_ctrl < 0; ++_M_ctrl, ++_M_slot);
+        }
+
+        const ctrl_type* _M_ctrl = nullptr;
+        const ctrl_type* _M_last = nullptr;
+
+        value_type* _M_slot = nullptr;
+    };
+
+    using iterator = basic_iterator<not is_map>;
+    using const_iterator = basic_iterator<true>;
+
+    FlatHashTable() noexcept = default;
+
+    explicit
+    FlatHashTable(size_type __n)
+    { reserve(__n); }
+
+    FlatHashTable(const FlatHashTable& __other)
+    {
+        reserve(__other.size());
+
+        for (const value_type& v : __other)
+        {
+            _M_emplace_unique(v);
+        }
+    }
+
+    FlatHashTable(FlatHashTable&& __other) noexcept
+    { swap(__other); }
+
+    FlatHashTable&
+    operator=(FlatHashTable __other) noexcept
+    {
+        swap(__other);
+        return *this;
+    }
+
+    ~FlatHashTable()
+    { _M_release(); }
+
+    void
+    swap(FlatHashTable& __other) noexcept
+    {
+        std::swap(_M_ctrl, __other._M_ctrl);
+        std::swap(_M_slots, __other._M_slots);
+        std::swap(_M_capacity, __other._M_capacity);
+        std::swap(_M_size, __other._M_size);
+        std::swap(_M_growth_left, __other._M_growth_left);
+    }
+
+    [[nodiscard]] iterator
+    begin() noexcept
+    { return {_M_ctrl, _M_ctrl + _M_capacity, _M_slots}; }
+
+    [[nodiscard]] iterator
+    end() noexcept
+    { return _M_at(_M_capacity); }
+
+    [[nodiscard]] const_iterator
+    begin() const noexcept
+    { return {_M_ctrl, _M_ctrl + _M_capacity, _M_slots}; }
+
+    [[nodiscard]] const_iterator
+    end() const noexcept
+    { return const_cast<FlatHashTable*>(this)->_M_at(_M_capacity); }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return _M_size; }
+
+    [[nodiscard]] bool
+    empty() const noexcept
+    { return _M_size == 0; }
+
+    /**
+     * @returns number of slots, a power of two and at least 16 once anything is stored
+     */
+    [[nodiscard]] size_type
+    capacity() const noexcept
+    { return _M_capacity; }
+
+    /**
+     * @brief Makes room for @p __n elements without rehashing, which also clears all tombstones.
+     */
+    void
+    reserve(size_type __n)
+    {
+        if (__n > _M_size + _M_growth_left or _M_size + _M_growth_left < _S_max_load(_M_capacity))
+        {
+            _M_rehash(std::max(_M_capacity, _S_capacity_for(std::max(__n, _M_size))));
+        }
+    }
+
+    void
+    clear() noexcept
+    {
+        _M_destroy_all();
+
+        if (_M_capacity)
+        {
+            std::fill_n(_M_ctrl, _M_capacity, _S_empty);
+        }
+
+        _M_size = 0;
+        _M_growth_left = _S_max_load(_M_capacity);
+    }
+
+    [[nodiscard]] iterator
+    find(const key_type& __key) noexcept
+    { return _M_at(_M_find(__key)); }
+
+    [[nodiscard]] const_iterator
+    find(const key_type& __key) const noexcept
+    { return const_cast<FlatHashTable*>(this)->_M_at(_M_find(__key)); }
+
+    [[nodiscard]] bool
+    contains(const key_type& __key) const noexcept
+    { return _M_find(__key) != _M_capacity; }
+
+    [[nodiscard]] size_type
+    count(const key_type& __key) const noexcept
+    { return contains(__key); }
+
+    /**
+     * @returns iterator to the element with @p __key, and whether it was inserted
+     */
+    template<typename... _Args>
+    std::pair<iterator, bool>
+    try_emplace(const key_type& __key, _Args&&... __args)
+    {
+        const hash_result_type h = _S_hash(__key);
+
+        if (const size_type i = _M_find(__key, h); i != _M_capacity)
+        {
+            return {_M_at(i), false};
+        }
+
+        const size_type i = _M_prepare_insert(h);
+
+        if constexpr (is_map)
+        {
+            std::construct_at(_M_slots + i, std::piecewise_construct, std::forward_as_tuple(__key), std::forward_as_tuple(std::forward<_Args>(__args)...));
+        }
+        else
+        {
+            std::construct_at(_M_slots + i, __key);
+        }
+
+        return {_M_at(i), true};
+    }
+
+    std::pair<iterator, bool>
+    insert(const value_type& __value)
+    {
+        if constexpr (is_map)
+        {
+            return try_emplace(__value.first, __value.second);
+        }
+        else
+        {
+            return try_emplace(__value);
+        }
+    }
+
+    template<std::input_iterator _Iter, std::sentinel_for<_Iter> _Sent>
+    void
+    insert(_Iter __first, _Sent __last)
+    {
+        for (; __first != __last; ++__first)
+        {
+            insert(*__first);
+        }
+    }
+
+    template<typename _Up = _Tp>
+    requires (not std::is_void_v<_Up>)
+    _Up&
+    operator[](const key_type& __key)
+    { return try_emplace(__key).first->second; }
+
+    template<typename _Up = _Tp>
+    requires (not std::is_void_v<_Up>)
+    [[nodiscard]] _Up&
+    at(const key_type& __key)
+    {
+        if (const size_type i = _M_find(__key); i != _M_capacity)
+        {
+            return _M_slots[i].second;
+        }
+
+        throw std::out_of_range("FlatHashTable::at");
+    }
+
+    template<typename _Up = _Tp>
+    requires (not std::is_void_v<_Up>)
+    [[nodiscard]] const _Up&
+    at(const key_type& __key) const
+    { return const_cast<FlatHashTable*>(this)->at(__key); }
+
+    /**
+     * @brief Leaves a tombstone, which is only reclaimed by the next rehash.
+     *
+     * @returns iterator past the erased element
+     */
+    iterator
+    erase(const_iterator __it) noexcept
+    {
+        const auto i = static_cast<size_type>(__it._M_ctrl - _M_ctrl);
+
+        std::destroy_at(_M_slots + i);
+        _M_ctrl[i] = _S_deleted;
+
+        --_M_size;
+        return {_M_ctrl + i + 1, _M_ctrl + _M_capacity, _M_slots + i + 1};
+    }
+
+    /**
+     * @returns 1 if @p __key was present, 0 otherwise
+     */
+    size_type
+    erase(const key_type& __key) noexcept
+    {
+        if (const size_type i = _M_find(__key); i != _M_capacity)
+        {
+            erase(const_iterator(_M_at(i)));
+            return 1;
+        }
+
+        return 0;
+    }
+
+private:
+
+    /**
+     * @brief Bit i set for every control byte i of the group.
+     */
+    class _Group
+    {
+    public:
+
+        explicit
+        _Group(const ctrl_type* __p) noexcept
+        {
+#if defined(__SSE2__)
+            _M_ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i*>(__p));
+#else
+            std::memcpy(_M_ctrl, __p, _S_group_width);
+#endif
+        }
+
+        [[nodiscard]] uint32
+        match(ctrl_type __h2) const noexcept
+        {
+#if defined(__SSE2__)
+            return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(__h2), _M_ctrl));
+#else
+            return _M_mask([__h2](ctrl_type c) -> bool { return c == __h2; });
+#endif
+        }
+
+        [[nodiscard]] uint32
+        match_empty() const noexcept
+        { return match(_S_empty); }
+
+        /**
+         * @note Both special values have the sign bit set and full slots do not.
+         */
+        [[nodiscard]] uint32
+        match_empty_or_deleted() const noexcept
+        {
+#if defined(__SSE2__)
+            return _mm_movemask_epi8(_M_ctrl);
+#else
+            return _M_mask([](ctrl_type c) -> bool { return c < 0; });
+#endif
+        }
+
+    private:
+
+#if defined(__SSE2__)
+        __m128i _M_ctrl;
+#else
+        template<typename _Pred>
+        [[nodiscard]] uint32
+        _M_mask(_Pred __pred) const noexcept
+        {
+            uint32 mask = 0;
+
+            for (size_type i = 0; i < _S_group_width; ++i)
+            {
+                mask |= uint32(__pred(_M_ctrl[i])) << i;
+            }
+
+            return mask;
+        }
+
+        ctrl_type _M_ctrl[_S_group_width];
+#endif
+    };
+
+    [[nodiscard]] static constexpr size_type
+    _S_max_load(size_type __capacity) noexcept
+    { return __capacity - __capacity / 8; }
+
+    [[nodiscard]] static constexpr size_type
+    _S_capacity_for(size_type __n) noexcept
+    { return __n ? std::bit_ceil(std::max(_S_group_width, __n + __n / 7 + 1)) : 0; }
+
+    [[nodiscard]] static ctrl_type
+    _S_h2(hash_result_type __h) noexcept
+    { return static_cast<ctrl_type>(__h >> 57); }
+
+    [[nodiscard]] static const key_type&
+    _S_key(const value_type& __v) noexcept
+    {
+        if constexpr (is_map)
+        {
+            return __v.first;
+        }
+        else
+        {
+            return __v;
+        }
+    }
+
+    [[nodiscard]] static hash_result_type
+    _S_hash(const key_type& __key) noexcept
+    {
+        // Golden-ratio multiply fills the high bits, the shift folds them back into the low ones.
+        const hash_result_type h = static_cast<hash_result_type>(hasher{}(__key)) * 0x9e3779b97f4a7c15;
+        return h ^ (h >> 32);
+    }
+
+    [[nodiscard]] iterator
+    _M_at(size_type __i) noexcept
+    {
+        iterator it;
+
+        it._M_ctrl = _M_ctrl + __i;
+        it._M_last = _M_ctrl + _M_capacity;
+        it._M_slot = _M_slots + __i;
+
+        return it;
+    }
+
+    [[nodiscard]] size_type
+    _M_find(const key_type& __key) const noexcept
+    { return _M_find(__key, _S_hash(__key)); }
+
+    /**
+     * @returns slot index of @p __key, or _M_capacity
+     */
+    [[nodiscard]] size_type
+    _M_find(const key_type& __key, hash_result_type __h) const noexcept
+    {
+        if (_M_capacity == 0)
+        {
+            return 0;
+        }
+
+        const size_type mask = _M_capacity / _S_group_width - 1;
+        const ctrl_type h2 = _S_h2(__h);
+
+        for (size_type g = __h & mask, step = 1; ; g = (g + step++) & mask)
+        {
+            const _Group group(_M_ctrl + g * _S_group_width);
+
+            for (uint32 bits = group.match(h2); bits; bits &= bits - 1)
+            {
+                const size_type i = g * _S_group_width + std::countr_zero(bits);
+
+                if (key_equal{}(_S_key(_M_slots[i]), __key)) [[likely]]
+                {
+                    return i;
+                }
+            }
+
+            if (group.match_empty())
+            {
+                return _M_capacity;
+            }
+        }
+    }
+
+    /**
+     * @returns first empty or deleted slot on the probe sequence of @p __h, marked full
+     */
+    size_type
+    _M_prepare_insert(hash_result_type __h)
+    {
+        size_type i = _M_find_free(__h);
+
+        if (_M_growth_left == 0 and (_M_capacity == 0 or _M_ctrl[i] == _S_empty))
+        {
+            // Rehash in place when tombstones make up a good part of the load, grow otherwise.
+            _M_rehash(_M_size * 2 < _S_max_load(_M_capacity) ? std::max(_M_capacity, _S_group_width) : std::max(_M_capacity * 2, _S_group_width));
+            i = _M_find_free(__h);
+        }
+
+        if (_M_ctrl[i] == _S_empty)
+        {
+            --_M_growth_left;
+        }
+
+        _M_ctrl[i] = _S_h2(__h);
+        ++_M_size;
+
+        return i;
+    }
+
+    [[nodiscard]] size_type
+    _M_find_free(hash_result_type __h) const noexcept
+    {
+        if (_M_capacity == 0)
+        {
+            return 0;
+        }
+
+        const size_type mask = _M_capacity / _S_group_width - 1;
+
+        for (size_type g = __h & mask, step = 1; ; g = (g + step++) & mask)
+        {
+            if (const uint32 bits = _Group(_M_ctrl + g * _S_group_width).match_empty_or_deleted())
+            {
+                return g * _S_group_width + std::countr_zero(bits);
+            }
+        }
+    }
+
+    /**
+     * @brief Inserts @p __value, known to be absent, with no lookup.
+     */
+    template<typename _Up>
+    void
+    _M_emplace_unique(_Up&& __value)
+    {
+        const size_type i = _M_prepare_insert(_S_hash(_S_key(__value)));
+        std::construct_at(_M_slots + i, std::forward<_Up>(__value));
+    }
+
+    void
+    _M_rehash(size_type __capacity)
+    {
+        ctrl_type* ctrl = _M_ctrl;
+        value_type* slots = _M_slots;
+
+        const size_type capacity = _M_capacity;
+
+        _M_ctrl = new ctrl_type[__capacity];
+        _M_slots = std::allocator<value_type>{}.allocate(__capacity);
+
+        _M_capacity = __capacity;
+        _M_size = 0;
+        _M_growth_left = _S_max_load(__capacity);
+
+        std::fill_n(_M_ctrl, __capacity, _S_empty);
+
+        for (size_type i = 0; i < capacity; ++i)
+        {
+            if (ctrl[i] >= 0)
+            {
+                _M_emplace_unique(std::move(slots[i]));
+                std::destroy_at(slots + i);
+            }
+        }
+
+        if (capacity)
+        {
+            delete[] ctrl;
+            std::allocator<value_type>{}.deallocate(slots, capacity);
+        }
+    }
+
+    void
+    _M_destroy_all() noexcept
+    {
+        if constexpr (not std::is_trivially_destructible_v<value_type>)
+        {
+            for (size_type i = 0; i < _M_capacity; ++i)
+            {
+                if (_M_ctrl[i] >= 0)
+                {
+                    std::destroy_at(_M_slots + i);
+                }
+            }
+        }
+    }
+
+    void
+    _M_release() noexcept
+    {
+        if (_M_capacity)
+        {
+            _M_destroy_all();
+
+            delete[] _M_ctrl;
+            std::allocator<value_type>{}.deallocate(_M_slots, _M_capacity);
+        }
+    }
+
+    ctrl_type* _M_ctrl = nullptr;
+    value_type* _M_slots = nullptr;
+
+    size_type _M_capacity = 0;
+    size_type _M_size = 0;
+
+    // insertions into empty slots left before the load factor reaches 7/8
+    size_type _M_growth_left = 0;
+};
+
+template<typename _Key, typename _Tp, typename _Hash = Hash<_Key>, typename _KeyEqual = std::equal_to<_Key>>
+using FlatHashMap = FlatHashTable<_Key, _Tp, _Hash, _KeyEqual>;
+
+template<typename _Key, typename _Hash = Hash<_Key>, typename _KeyEqual = std::equal_to<_Key>>
+using FlatHashSet = FlatHashTable<_Key, void, _Hash, _KeyEqual>;
@@ -131,27 +131,109 @@ struct Hash<void>
     }
 };
 
-class RangeHash
+/**
+ * @brief Arithmetic backends for BasicRangeHash: @c base, @c mod, and @c reduce / @c add / @c sub / @c mul on [0, mod).
+ */
+struct HashPolicy
+{
+    template<hash_result_type _Base = hash_base, hash_result_type _Mod = hash_mod>
+    struct Mod
+    {
+        static_assert(_Base < _Mod);
+        static_assert(_Mod <= std::numeric_limits<hash_result_type>::max() / _Mod);
+
+        static constexpr hash_result_type base = _Base;
+        static constexpr hash_result_type mod = _Mod;
+
+        [[nodiscard]] static constexpr hash_result_type
+        reduce(hash_result_type __a) noexcept
+        { return __a % mod; }
+
+        [[nodiscard]] static constexpr hash_result_type
+        add(hash_result_type __a, hash_result_type __b) noexcept
+        { return __a + __b >= mod ? __a + __b - mod : __a + __b; }
+
+        [[nodiscard]] static constexpr hash_result_type
+        sub(hash_result_type __a, hash_result_type __b) noexcept
+        { return __a >= __b ? __a - __b : __a + mod - __b; }
+
+        [[nodiscard]] static constexpr hash_result_type
+        mul(hash_result_type __a, hash_result_type __b) noexcept
+        { return __a * __b % mod; }
+    };
+
+    /**
+     * @brief mod 2^61 - 1: 128-bit product folded with a shift and an add, no division at all.
+     */
+    template<hash_result_type _Base = 0x9e3779b97f4a7c1>
+    struct Mersenne61
+    {
+        static constexpr hash_result_type base = _Base;
+        static constexpr hash_result_type mod = (hash_result_type{1} << 61) - 1;
+
+        static_assert(_Base < mod);
+
+        [[nodiscard]] static constexpr hash_result_type
+        reduce(hash_result_type __a) noexcept
+        { return _S_canonical((__a & mod) + (__a >> 61)); }
+
+        [[nodiscard]] static constexpr hash_result_type
+        add(hash_result_type __a, hash_result_type __b) noexcept
+        { return _S_canonical(__a + __b); }
+
+        [[nodiscard]] static constexpr hash_result_type
+        sub(hash_result_type __a, hash_result_type __b) noexcept
+        { return _S_canonical(__a + mod - __b); }
+
+        [[nodiscard]] static constexpr hash_result_type
+        mul(hash_result_type __a, hash_result_type __b) noexcept
+        {
+            const uint128 p = static_cast<uint128>(__a) * __b;
+
+            // a, b < mod gives p < mod * 2^61, so one conditional subtraction is enough.
+            return _S_canonical((static_cast<hash_result_type>(p) & mod) + static_cast<hash_result_type>(p >> 61));
+        }
+
+    private:
+
+        /**
+         * @brief [0, 2 mod) -> [0, mod) without a branch, the comparisons above are unpredictable on hash values.
+         */
+        [[nodiscard]] static constexpr hash_result_type
+        _S_canonical(hash_result_type __a) noexcept
+        {
+            __a -= mod;
+            return __a + (mod & -(__a >> 63));
+        }
+    };
+};
+
+/**
+ * @brief Prefix hashes of a range over the arithmetic of @p _Policy; RangeHash is the default HashPolicy::Mod<>.
+ */
+template<typename _Policy = HashPolicy::Mod<>>
+class BasicRangeHash
 {
 public:
 
+    using policy_type = _Policy;
     using container_type = std::vector<std::pair<hash_result_type, hash_result_type>>;
     using size_type = std::size_t;
 
     static constexpr auto npos = static_cast<size_type>(-1);
 
-    RangeHash() noexcept
+    BasicRangeHash() noexcept
         : _M_c{{0, 1}}
     { };
 
     template<std::input_iterator _Iter, std::sentinel_for<_Iter> _Sent>
-    RangeHash(_Iter __first, _Sent __last)
-        : RangeHash()
+    BasicRangeHash(_Iter __first, _Sent __last)
+        : BasicRangeHash()
     { append(__first, __last); }
 
     template<std::ranges::input_range _Range>
-    RangeHash(_Range&& __r)
-        : RangeHash()
+    BasicRangeHash(_Range&& __r)
+        : BasicRangeHash()
     { append(std::forward<_Range>(__r)); }
 
     template<typename _Tp>
@@ -159,8 +241,8 @@ public:
     push_back(const _Tp& __value)
     {
         _M_c.emplace_back(
-            (_M_c.back().first * hash_base % hash_mod + Hash<void>{}(__value) % hash_mod) % hash_mod,
-            _M_c.back().second * hash_base % hash_mod);
+            _Policy::add(_Policy::mul(_M_c.back().first, _Policy::base), _Policy::reduce(Hash<void>{}(__value))),
+            _Policy::mul(_M_c.back().second, _Policy::base));
     }
 
     template<std::input_iterator _Iter, std::sentinel_for<_Iter> _Sent>
@@ -214,7 +296,7 @@ public:
             __n = _M_c.size() - __pos - 1;
         }
 
-        return (_M_c[__pos + __n].first + hash_mod - _M_c[__pos].first * _M_c[__n].second % hash_mod) % hash_mod;
+        return _Policy::sub(_M_c[__pos + __n].first, _Policy::mul(_M_c[__pos].first, _M_c[__n].second));
     }
 
     [[nodiscard]] hash_result_type
@@ -230,59 +312,131 @@ public:
     { return empty() ? 0 : (*this)(size() - std::min(__n, size()), std::min(__n, size())); }
 
     [[nodiscard]] bool
-    operator==(const RangeHash& __rhs) const noexcept
+    operator==(const BasicRangeHash& __rhs) const noexcept
     { return (*this)() == __rhs(); }
 
     [[nodiscard]] bool
-    operator!=(const RangeHash& __rhs) const noexcept
+    operator!=(const BasicRangeHash& __rhs) const noexcept
     { return (*this)() != __rhs(); }
 
     [[nodiscard]] bool
-    operator<(const RangeHash& __rhs) const noexcept
+    operator<(const BasicRangeHash& __rhs) const noexcept
     { return (*this)() < __rhs(); }
 
     [[nodiscard]] bool
-    operator<=(const RangeHash& __rhs) const noexcept
+    operator<=(const BasicRangeHash& __rhs) const noexcept
     { return (*this)() <= __rhs(); }
 
     [[nodiscard]] bool
-    operator>(const RangeHash& __rhs) const noexcept
+    operator>(const BasicRangeHash& __rhs) const noexcept
     { return (*this)() > __rhs(); }
 
     [[nodiscard]] bool
-    operator>=(const RangeHash& __rhs) const noexcept
+    operator>=(const BasicRangeHash& __rhs) const noexcept
     { return (*this)() >= __rhs(); }
 
     [[nodiscard]] bool
-    matches(const RangeHash& __h, size_type __pos) const noexcept
+    matches(const BasicRangeHash& __h, size_type __pos) const noexcept
     { return (*this)(__pos, __h.size()) == __h(); }
 
     [[nodiscard]] bool
-    starts_with(const RangeHash& __h) const noexcept
+    starts_with(const BasicRangeHash& __h) const noexcept
     { return matches(__h, 0); }
 
     [[nodiscard]] bool
-    ends_with(const RangeHash& __h) const noexcept
+    ends_with(const BasicRangeHash& __h) const noexcept
     { return matches(__h, size() - std::min(__h.size(), size())); }
 
     [[nodiscard]] size_type
-    find(const RangeHash& __h, size_type __pos = 0) const noexcept
+    find(const BasicRangeHash& __h, size_type __pos = 0) const noexcept
     {
-        const auto n1 = size(), n2 = __h.size();
+        size_type res = npos;
 
-        for (; __pos + n2 <= n1; ++__pos)
+        _M_scan(__pos, __h.size(), [target = __h()](hash_result_type __x) -> bool { return __x == target; },
+            [&res](size_type __i) -> bool { res = __i; return false; });
+
+        return res;
+    }
+
+    /**
+     * @brief Writes every position where @p __h occurs, in increasing order.
+     */
+    template<std::output_iterator<size_type> _Out>
+    _Out
+    find_all(const BasicRangeHash& __h, _Out __result) const
+    {
+        _M_scan(0, __h.size(), [target = __h()](hash_result_type __x) -> bool { return __x == target; },
+            [&__result](size_type __i) -> bool { *__result = __i; ++__result; return true; });
+
+        return __result;
+    }
+
+    /**
+     * @brief Writes every position where any of @p __patterns occurs, in increasing order, with one hash set lookup
+     * per window.
+     *
+     * @tparam _Set set of hash_result_type with contains(), e.g. FlatHashSet<hash_result_type>
+     * @param __patterns RangeHash objects, all of the same length
+     */
+    template<typename _Set = std::unordered_set<hash_result_type>, std::ranges::input_range _Patterns, std::output_iterator<size_type> _Out>
+    _Out
+    find_all_of(_Patterns&& __patterns, _Out __result) const
+    {
+        const auto [targets, n] = _S_pattern_set<_Set>(__patterns);
+
+        if (n != npos)
         {
-            if (matches(__h, __pos))
+            _M_scan(0, n, [&targets](hash_result_type __x) -> bool { return targets.contains(__x); },
+                [&__result](size_type __i) -> bool { *__result = __i; ++__result; return true; });
+        }
+
+        return __result;
+    }
+
+#if __has_include(<generator>) && defined(__cpp_lib_generator)
+    [[nodiscard]] std::generator<size_type>
+    find_all(const BasicRangeHash& __h) const
+    {
+        const hash_result_type target = __h();
+
+        for (_WindowBlocks it(*this, 0, __h.size()); it; ++it)
+        {
+            for (size_type k = 0; k < it.count(); ++k)
             {
-                return __pos;
+                if (it[k] == target)
+                {
+                    co_yield it.pos() + k;
+                }
             }
         }
+    }
 
-        return npos;
+    template<typename _Set = std::unordered_set<hash_result_type>, std::ranges::input_range _Patterns>
+    [[nodiscard]] std::generator<size_type>
+    find_all_of(_Patterns&& __patterns) const
+    {
+        const auto [targets, n] = _S_pattern_set<_Set>(__patterns);
+
+        if (n == npos)
+        {
+            co_return;
+        }
+
+        for (_WindowBlocks it(*this, 0, n); it; ++it)
+        {
+            for (size_type k = 0; k < it.count(); ++k)
+            {
+                if (targets.contains(it[k]))
+                {
+                    co_yield it.pos() + k;
+                }
+            }
+        }
     }
+#endif
 
     [[nodiscard]] size_type
-    rfind(const RangeHash& __h, size_type __pos = std::numeric_limits<size_type>::max()) const noexcept
+    rfind(const BasicRangeHash& __h, size_type __pos = std::numeric_limits<size_type>::max()) const noexcept
     {
         const auto n1 = size(), n2 = __h.size();
 
@@ -307,7 +461,7 @@ public:
     }
 
     [[nodiscard]] bool
-    contains(const RangeHash& __h) const noexcept
+    contains(const BasicRangeHash& __h) const noexcept
     { return find(__h) != npos; }
 
     enum OverlapMode
@@ -317,29 +471,33 @@ public:
     };
 
     [[nodiscard]] size_type
-    count(const RangeHash& __h, OverlapMode __mode = AllowOverlap) const noexcept
+    count(const BasicRangeHash& __h, OverlapMode __mode = AllowOverlap) const noexcept
     {
         if (__h.size() == 0)
         {
             return 0;
         }
 
-        size_type cnt = 0;
+        size_type cnt = 0, next = 0;
 
-        if (__mode == AllowOverlap)
-        {
-            for (size_type pos = find(__h); pos != npos; ++cnt, pos = find(__h, pos + 1));
-        }
-        else
-        {
-            for (size_type pos = find(__h); pos != npos; ++cnt, pos = find(__h, pos + __h.size()));
-        }
+        // One pass either way, NoOverlap just skips hits inside the previous one.
+        _M_scan(0, __h.size(), [target = __h()](hash_result_type __x) -> bool { return __x == target; },
+            [&, step = __mode == AllowOverlap ? 1 : __h.size()](size_type __i) -> bool
+            {
+                if (__i >= next)
+                {
+                    ++cnt;
+                    next = __i + step;
+                }
+
+                return true;
+            });
 
         return cnt;
     }
 
     [[nodiscard]] size_type
-    longest_suffix_prefix_overlap(const RangeHash& __h) const noexcept
+    longest_suffix_prefix_overlap(const BasicRangeHash& __h) const noexcept
     {
         for (size_type i = std::min(size(), __h.size()); i > 0; --i)
         {
@@ -354,5 +512,704 @@ public:
 
 private:
 
+    static constexpr size_type _S_block = 64;
+
+    /**
+     * @brief Hashes of the windows of length n starting at pos, pos + 1, ..., _S_block of them at a time.
+     *
+     * Window hashes are independent of each other, so a whole block is computed before any of them is compared,
+     * which keeps the multiply-subtract chain free of branches and lets consecutive windows overlap in the pipeline.
+     */
+    class _WindowBlocks
+    {
+    public:
+
+        _WindowBlocks(const BasicRangeHash& __h, size_type __pos, size_type __n) noexcept
+            : _M_c(__h._M_c.data()), _M_n(__n), _M_pw(__n <= __h.size() ? __h._M_c[__n].second : 0),
+              _M_pos(__pos), _M_last(__n <= __h.size() ? __h.size() - __n + 1 : 0)
+        { _M_fill(); }
+
+        [[nodiscard]] explicit
+        operator bool() const noexcept
+        { return _M_pos < _M_last; }
+
+        _WindowBlocks&
+        operator++() noexcept
+        {
+            _M_pos += _S_block;
+            _M_fill();
+
+            return *this;
+        }
+
+        [[nodiscard]] size_type
+        pos() const noexcept
+        { return _M_pos; }
+
+        [[nodiscard]] size_type
+        count() const noexcept
+        { return _M_count; }
+
+        [[nodiscard]] hash_result_type
+        operator[](size_type __k) const noexcept
+        { return _M_hash[__k]; }
+
+    private:
+
+        void
+        _M_fill() noexcept
+        {
+            _M_count = _M_pos < _M_last ? std::min(_S_block, _M_last - _M_pos) : 0;
+
+            const auto* c = _M_c + _M_pos;
+
+            for (size_type k = 0; k < _M_count; ++k)
+            {
+                _M_hash[k] = _Policy::sub(c[k + _M_n].first, _Policy::mul(c[k].first, _M_pw));
+            }
+        }
+
+        const typename container_type::value_type* _M_c;
+
+        size_type _M_n;
+        hash_result_type _M_pw;
+
+        size_type _M_pos;
+        size_type _M_last;
+        size_type _M_count = 0;
+
+        hash_result_type _M_hash[_S_block];
+    };
+
+    /**
+     * @brief Calls @p __f(i) for every window [i, i + n), i >= pos, whose hash satisfies @p __pred, until @p __f returns false.
+     */
+    template<typename _Pred, typename _Func>
+    void
+    _M_scan(size_type __pos, size_type __n, _Pred __pred, _Func __f) const
+    {
+        for (_WindowBlocks it(*this, __pos, __n); it; ++it)
+        {
+            for (size_type k = 0; k < it.count(); ++k)
+            {
+                if (__pred(it[k]) and not __f(it.pos() + k))
+                {
+                    return;
+                }
+            }
+        }
+    }
+
+    /**
+     * @returns hashes of @p __patterns and their common length, npos if there are none
+     */
+    template<typename _Set, typename _Patterns>
+    [[nodiscard]] static std::pair<_Set, size_type>
+    _S_pattern_set(_Patterns& __patterns)
+    {
+        _Set targets;
+        size_type n = npos;
+
+        for (const BasicRangeHash& p : __patterns)
+        {
+            assert(n == npos or n == p.size());
+
+            n = p.size();
+            targets.insert(p());
+        }
+
+        return {std::move(targets), n};
+    }
+
     container_type _M_c;
-};
\ No newline at end of file
+};
+
+using RangeHash = BasicRangeHash<>;
+
+/**
+ * @brief RangeHash with O(log n) point assignment, on two Fenwick trees over c_i B^-i and c_i B^i.
+ *
+ * A forward window sum times B^(pos + n - 1) gives the same value as RangeHash over that substring, and a backward
+ * window sum times B^-pos gives the hash of the reversed substring, so palindromes are one comparison.
+ *
+ * @note The policy's modulus must be prime, B^-1 is taken by Fermat.
+ */
+template<typename _Policy = HashPolicy::Mod<>>
+class DynamicRangeHash
+{
+public:
+
+    using policy_type = _Policy;
+    using size_type = std::size_t;
+
+    DynamicRangeHash() noexcept = default;
+
+    /**
+     * @brief @p __n elements that all hash to 0.
+     */
+    explicit
+    DynamicRangeHash(size_type __n)
+        : _M_value(__n)
+    { _M_build(); }
+
+    template<std::input_iterator _Iter, std::sentinel_for<_Iter> _Sent>
+    DynamicRangeHash(_Iter __first, _Sent __last)
+    {
+        for (; __first != __last; ++__first)
+        {
+            _M_value.push_back(_Policy::reduce(Hash<void>{}(*__first)));
+        }
+
+        _M_build();
+    }
+
+    template<std::ranges::input_range _Range>
+    DynamicRangeHash(_Range&& __r)
+        : DynamicRangeHash(std::ranges::begin(__r), std::ranges::end(__r))
+    { }
+
+    /**
+     * @brief Replaces element @p __i with @p __value, O(log n).
+     */
+    template<typename _Tp>
+    void
+    set(size_type __i, const _Tp& __value)
+    { _M_set(__i, _Policy::reduce(Hash<void>{}(__value))); }
+
+    /**
+     * @brief Applies (index, value) pairs in order; when there are enough of them to beat k log n,
+     * the trees are rebuilt once in O(n) instead.
+     */
+    template<std::ranges::input_range _Range>
+    void
+    set(_Range&& __updates)
+    {
+        if constexpr (std::ranges::sized_range<_Range>)
+        {
+            if (std::ranges::size(__updates) * std::bit_width(size()) >= size())
+            {
+                for (const auto& [i, value] : __updates)
+                {
+                    _M_value[i] = _Policy::reduce(Hash<void>{}(value));
+                }
+
+                _M_build();
+                return;
+            }
+        }
+
+        for (const auto& [i, value] : __updates)
+        {
+            set(i, value);
+        }
+    }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return _M_value.size(); }
+
+    [[nodiscard]] bool
+    empty() const noexcept
+    { return size() == 0; }
+
+    [[nodiscard]] hash_result_type
+    operator()() const noexcept
+    { return (*this)(0, size()); }
+
+    /**
+     * @returns hash of [pos, pos + n) clamped to the end, the same as RangeHash over that substring
+     */
+    [[nodiscard]] hash_result_type
+    operator()(size_type __pos, size_type __n) const noexcept
+    {
+        if (__pos >= size() or __n == 0)
+        {
+            return 0;
+        }
+
+        __n = std::min(__n, size() - __pos);
+        return _Policy::mul(_Policy::sub(_M_sum(__pos + __n).first, _M_sum(__pos).first), _M_pw[__pos + __n - 1]);
+    }
+
+    /**
+     * @returns hash of [pos, pos + n) read backwards, clamped to the end
+     */
+    [[nodiscard]] hash_result_type
+    reversed(size_type __pos, size_type __n) const noexcept
+    {
+        if (__pos >= size() or __n == 0)
+        {
+            return 0;
+        }
+
+        __n = std::min(__n, size() - __pos);
+        return _Policy::mul(_Policy::sub(_M_sum(__pos + __n).second, _M_sum(__pos).second), _M_ipw[__pos]);
+    }
+
+    [[nodiscard]] bool
+    is_palindrome(size_type __pos, size_type __n) const noexcept
+    {
+        if (__pos >= size() or __n == 0)
+        {
+            return true;
+        }
+
+        // One pass over both trees for both directions.
+        __n = std::min(__n, size() - __pos);
+
+        const auto [fr, br] = _M_sum(__pos + __n);
+        const auto [fl, bl] = _M_sum(__pos);
+
+        return _Policy::mul(_Policy::sub(fr, fl), _M_pw[__pos + __n - 1]) == _Policy::mul(_Policy::sub(br, bl), _M_ipw[__pos]);
+    }
+
+    [[nodiscard]] bool
+    equal(size_type __pos1, size_type __pos2, size_type __n) const noexcept
+    { return (*this)(__pos1, __n) == (*this)(__pos2, __n); }
+
+private:
+
+    static constexpr hash_result_type
+    _S_pow(hash_result_type __a, hash_result_type __e) noexcept
+    {
+        hash_result_type res = 1;
+
+        for (; __e; __e >>= 1, __a = _Policy::mul(__a, __a))
+        {
+            if (__e & 1)
+            {
+                res = _Policy::mul(res, __a);
+            }
+        }
+
+        return res;
+    }
+
+    static constexpr hash_result_type _S_inv_base = _S_pow(_Policy::base, _Policy::mod - 2);
+
+    /**
+     * @returns (sum of c_j B^-j, sum of c_j B^j) over j < @p __k
+     */
+    [[nodiscard]] std::pair<hash_result_type, hash_result_type>
+    _M_sum(size_type __k) const noexcept
+    {
+        hash_result_type f = 0, b = 0;
+
+        for (; __k; __k &= __k - 1)
+        {
+            f = _Policy::add(f, _M_tree[__k].first);
+            b = _Policy::add(b, _M_tree[__k].second);
+        }
+
+        return {f, b};
+    }
+
+    void
+    _M_set(size_type __i, hash_result_type __c)
+    {
+        const hash_result_type delta = _Policy::sub(__c, _M_value[__i]);
+        _M_value[__i] = __c;
+
+        const hash_result_type df = _Policy::mul(delta, _M_ipw[__i]);
+        const hash_result_type db = _Policy::mul(delta, _M_pw[__i]);
+
+        for (++__i; __i <= size(); __i += __i & -__i)
+        {
+            _M_tree[__i].first = _Policy::add(_M_tree[__i].first, df);
+            _M_tree[__i].second = _Policy::add(_M_tree[__i].second, db);
+        }
+    }
+
+    /**
+     * @brief Powers, inverse powers and both trees from _M_value, O(n).
+     */
+    void
+    _M_build()
+    {
+        const size_type n = size();
+
+        _M_pw.resize(n + 1);
+        _M_ipw.resize(n + 1);
+        _M_tree.assign(n + 1, {});
+
+        _M_pw[0] = _M_ipw[0] = 1;
+
+        for (size_type i = 0; i < n; ++i)
+        {
+            _M_pw[i + 1] = _Policy::mul(_M_pw[i], _Policy::base);
+            _M_ipw[i + 1] = _Policy::mul(_M_ipw[i], _S_inv_base);
+
+            _M_tree[i + 1] = {_Policy::mul(_M_value[i], _M_ipw[i]), _Policy::mul(_M_value[i], _M_pw[i])};
+        }
+
+        for (size_type i = 1; i <= n; ++i)
+        {
+            if (const size_type j = i + (i & -i); j <= n)
+            {
+                _M_tree[j].first = _Policy::add(_M_tree[j].first, _M_tree[i].first);
+                _M_tree[j].second = _Policy::add(_M_tree[j].second, _M_tree[i].second);
+            }
+        }
+    }
+
+    // reduced element hashes
+    std::vector<hash_result_type> _M_value;
+
+    std::vector<hash_result_type> _M_pw;
+    std::vector<hash_result_type> _M_ipw;
+
+    // 1-based Fenwick, node k holds (forward, backward) sums over (k - lowbit(k), k]
+    std::vector<std::pair<hash_result_type, hash_result_type>> _M_tree;
+};
+
+/**
+ * @brief GCC vector extension type of @p _Lanes elements, lowered to SSE2 / AVX2 registers where available.
+ */
+template<typename _Tp, std::size_t _Lanes>
+using simd_vector [[gnu::vector_size(sizeof(_Tp) * _Lanes)]] = _Tp;
+
+/**
+ * @brief RangeHash with @p _Lanes independent hashes per prefix (distinct primes just under 2^30), evaluated together.
+ *
+ * Prefix hashes and powers live in two separate flat arrays, @p _Lanes 64-bit words per prefix, each loaded as one
+ * vector. Multiplication is Montgomery on the low 32 bits of every lane, i.e. one pmuludq per product on SSE2 / AVX2,
+ * with no division. Prefix hashes are kept in normal form and powers in Montgomery form, so mont(h, B^n R) = h B^n.
+ *
+ * @note The intrinsics need <immintrin.h> from the contest template prelude; without SSE2 plain vector code is used.
+ */
+template<std::size_t _Lanes = 2>
+class MultiRangeHash
+{
+    static_assert(_Lanes == 1 or _Lanes == 2 or _Lanes == 4 or _Lanes == 8);
+
+public:
+
+    using lane_type = simd_vector<uint64, _Lanes>;
+
+    struct hash_type
+    {
+        lane_type lanes;
+
+        /**
+         * @returns whether all lanes agree
+         */
+        [[nodiscard]] friend bool
+        operator==(const hash_type& __lhs, const hash_type& __rhs) noexcept
+        {
+            const lane_type diff = __lhs.lanes ^ __rhs.lanes;
+            uint64 any = 0;
+
+            for (std::size_t k = 0; k < _Lanes; ++k)
+            {
+                any |= diff[k];
+            }
+
+            return any == 0;
+        }
+    };
+
+    // lanes of prefix i are [i * _Lanes, (i + 1) * _Lanes)
+    using container_type = std::vector<uint64>;
+    using size_type = std::size_t;
+
+    static constexpr auto npos = static_cast<size_type>(-1);
+
+    MultiRangeHash()
+        : _M_h(_Lanes), _M_pw(_Lanes)
+    { _S_store(_M_pw, 0, _S_one); }
+
+    template<std::input_iterator _Iter, std::sentinel_for<_Iter> _Sent>
+    MultiRangeHash(_Iter __first, _Sent __last)
+        : MultiRangeHash()
+    { append(__first, __last); }
+
+    template<std::ranges::input_range _Range>
+    MultiRangeHash(_Range&& __r)
+        : MultiRangeHash()
+    { append(std::forward<_Range>(__r)); }
+
+    template<typename _Tp>
+    void
+    push_back(const _Tp& __value)
+    {
+        const size_type n = size();
+
+        _M_h.resize(_M_h.size() + _Lanes);
+        _M_pw.resize(_M_pw.size() + _Lanes);
+
+        _S_store(_M_h, n + 1, _S_step(_S_load(_M_h, n), __value));
+        _S_store(_M_pw, n + 1, _S_mont(_S_load(_M_pw, n), _S_base));
+    }
+
+    template<std::input_iterator _Iter, std::sentinel_for<_Iter> _Sent>
+    void
+    append(_Iter __first, _Sent __last)
+    {
+        if constexpr (std::sized_sentinel_for<_Sent, _Iter>)
+        {
+            // Size once and carry the running prefix and power in registers.
+            size_type i = size();
+            const auto n = static_cast<size_type>(std::ranges::distance(__first, __last));
+
+            _M_h.resize(_M_h.size() + n * _Lanes);
+            _M_pw.resize(_M_pw.size() + n * _Lanes);
+
+            hash_type h = _S_load(_M_h, i);
+            hash_type pw = _S_load(_M_pw, i);
+
+            for (; __first != __last; ++__first)
+            {
+                h = _S_step(h, *__first);
+                pw = _S_mont(pw, _S_base);
+
+                _S_store(_M_h, ++i, h);
+                _S_store(_M_pw, i, pw);
+            }
+        }
+        else
+        {
+            for (; __first != __last; ++__first)
+            {
+                push_back(*__first);
+            }
+        }
+    }
+
+    template<std::ranges::input_range _Range>
+    void
+    append(_Range&& __r)
+    { append(std::ranges::begin(__r), std::ranges::end(__r)); }
+
+    void
+    pop_back(size_type __n = 1)
+    {
+        _M_h.resize(_M_h.size() - std::min(__n, size()) * _Lanes);
+        _M_pw.resize(_M_h.size());
+    }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return _M_h.size() / _Lanes - 1; }
+
+    [[nodiscard]] bool
+    empty() const noexcept
+    { return size() == 0; }
+
+    [[nodiscard]] hash_type
+    operator()() const noexcept
+    { return _S_load(_M_h, size()); }
+
+    [[nodiscard]] hash_type
+    operator()(size_type __pos, size_type __n) const noexcept
+    {
+        if (__pos >= size())
+        {
+            return hash_type{};
+        }
+
+        return _M_substr(__pos, std::min(__n, size() - __pos));
+    }
+
+    /**
+     * @brief Compares [pos1, pos1 + n) with [pos2, pos2 + n), both in range, on every lane at once.
+     */
+    [[nodiscard]] bool
+    equal(size_type __pos1, size_type __pos2, size_type __n) const noexcept
+    { return _M_substr(__pos1, __n) == _M_substr(__pos2, __n); }
+
+    [[nodiscard]] hash_type
+    front(size_type __n = 1) const noexcept
+    { return _S_load(_M_h, std::min(__n, size())); }
+
+    [[nodiscard]] hash_type
+    back(size_type __n = 1) const noexcept
+    { return empty() ? hash_type{} : (*this)(size() - std::min(__n, size()), std::min(__n, size())); }
+
+    [[nodiscard]] bool
+    operator==(const MultiRangeHash& __rhs) const noexcept
+    { return (*this)() == __rhs(); }
+
+    [[nodiscard]] bool
+    matches(const MultiRangeHash& __h, size_type __pos) const noexcept
+    { return (*this)(__pos, __h.size()) == __h(); }
+
+    [[nodiscard]] bool
+    starts_with(const MultiRangeHash& __h) const noexcept
+    { return matches(__h, 0); }
+
+    [[nodiscard]] bool
+    ends_with(const MultiRangeHash& __h) const noexcept
+    { return matches(__h, size() - std::min(__h.size(), size())); }
+
+    [[nodiscard]] size_type
+    find(const MultiRangeHash& __h, size_type __pos = 0) const noexcept
+    {
+        const auto n1 = size(), n2 = __h.size();
+        const hash_type target = __h();
+
+        for (; __pos + n2 <= n1; ++__pos)
+        {
+            if (_M_substr(__pos, n2) == target)
+            {
+                return __pos;
+            }
+        }
+
+        return npos;
+    }
+
+    [[nodiscard]] bool
+    contains(const MultiRangeHash& __h) const noexcept
+    { return find(__h) != npos; }
+
+private:
+
+    static constexpr std::array<uint64, 8> _S_mods{998244353, 1004535809, 1000000007, 1000000009, 1000000021, 1000000033, 1000000087, 1000000093};
+    static constexpr std::array<uint64, 8> _S_bases{449, 100003, 1000003, 131, 13331, 91138233, 972663749, 911382323};
+
+    // Vectors cross function boundaries wrapped in hash_type, by reference or in memory: a by-value 32 / 64 byte
+    // vector argument or return changes ABI without AVX / AVX-512 (-Wpsabi).
+    template<typename _Func>
+    static constexpr hash_type
+    _S_make(_Func __f) noexcept
+    {
+        return [&]<std::size_t... _Ks>(std::index_sequence<_Ks...>) -> hash_type {
+            return {lane_type{__f(_Ks)...}};
+        }(std::make_index_sequence<_Lanes>{});
+    }
+
+    // -m^-1 mod 2^32, by Newton iteration
+    static constexpr uint64
+    _S_neg_inv(uint64 __m) noexcept
+    {
+        uint32 inv = uint32(__m);
+
+        for (int i = 0; i < 5; ++i)
+        {
+            inv *= 2 - uint32(__m) * inv;
+        }
+
+        return uint32(-inv);
+    }
+
+    static constexpr hash_type _S_mod = _S_make([](std::size_t k) -> uint64 { return _S_mods[k]; });
+    static constexpr hash_type _S_minv = _S_make([](std::size_t k) -> uint64 { return _S_neg_inv(_S_mods[k]); });
+
+    // B R (R = 2^32): mont(h, B R) = h B keeps prefixes in normal form and steps powers in Montgomery form.
+    static constexpr hash_type _S_base = _S_make([](std::size_t k) -> uint64 { return (_S_bases[k] << 32) % _S_mods[k]; });
+    static constexpr hash_type _S_one = _S_make([](std::size_t k) -> uint64 { return (uint64{1} << 32) % _S_mods[k]; });
+
+    [[nodiscard]] hash_type
+    _M_substr(size_type __pos, size_type __n) const noexcept
+    { return _S_sub(_S_load(_M_h, __pos + __n), _S_mont(_S_load(_M_h, __pos), _S_load(_M_pw, __n))); }
+
+    [[nodiscard]] static hash_type
+    _S_load(const container_type& __c, size_type __i) noexcept
+    {
+        hash_type v;
+        std::memcpy(&v.lanes, __c.data() + __i * _Lanes, sizeof(v.lanes));
+        return v;
+    }
+
+    static void
+    _S_store(container_type& __c, size_type __i, const hash_type& __v) noexcept
+    { std::memcpy(__c.data() + __i * _Lanes, &__v.lanes, sizeof(__v.lanes)); }
+
+    /**
+     * @returns h B + value on every lane
+     */
+    template<typename _Tp>
+    [[nodiscard]] static hash_type
+    _S_step(const hash_type& __h, const _Tp& __value) noexcept
+    {
+        // Every lane reduces the whole 64-bit element hash x = hi 2^32 + lo by its own modulus, as
+        // x R^-1 = hi + lo R^-1 (a bijection on residues): mont(hi, R) = hi and redc(lo) = lo R^-1, both valid for
+        // 32-bit inputs. Two elements then collide on all lanes only if their hashes agree mod every prime.
+        const hash_result_type x = Hash<void>{}(__value);
+
+        const hash_type hi = _S_mont({lane_type{} + (x >> 32)}, _S_one);
+        const hash_type lo = _S_redc({lane_type{} + (x & 0xffffffff)});
+
+        const hash_type c = _S_reduce({hi.lanes + lo.lanes});
+        return _S_reduce({_S_mont(__h, _S_base).lanes + c.lanes});
+    }
+
+    /**
+     * @brief [0, 2 mod) -> [0, mod) per lane, without a 64-bit compare.
+     */
+    [[nodiscard]] static hash_type
+    _S_reduce(const hash_type& __a) noexcept
+    {
+        const lane_type a = __a.lanes - _S_mod.lanes;
+        return {a + (_S_mod.lanes & -(a >> 63))};
+    }
+
+    [[nodiscard]] static hash_type
+    _S_sub(const hash_type& __a, const hash_type& __b) noexcept
+    { return _S_reduce({__a.lanes + _S_mod.lanes - __b.lanes}); }
+
+    /**
+     * @returns (a mod 2^32) (b mod 2^32) per lane, pmuludq on SSE2 / AVX2.
+     */
+    [[nodiscard]] static hash_type
+    _S_mul32(const hash_type& __a, const hash_type& __b) noexcept
+    {
+#if defined(__AVX2__)
+        if constexpr (sizeof(lane_type) % sizeof(__m256i) == 0)
+        {
+            hash_type r;
+
+            for (std::size_t i = 0; i < sizeof(lane_type); i += sizeof(__m256i))
+            {
+                __m256i x, y;
+                std::memcpy(&x, reinterpret_cast<const char*>(&__a.lanes) + i, sizeof(x));
+                std::memcpy(&y, reinterpret_cast<const char*>(&__b.lanes) + i, sizeof(y));
+
+                x = _mm256_mul_epu32(x, y);
+                std::memcpy(reinterpret_cast<char*>(&r.lanes) + i, &x, sizeof(x));
+            }
+
+            return r;
+        }
+#endif
+#if defined(__SSE2__)
+        if constexpr (sizeof(lane_type) % sizeof(__m128i) == 0)
+        {
+            hash_type r;
+
+            for (std::size_t i = 0; i < sizeof(lane_type); i += sizeof(__m128i))
+            {
+                __m128i x, y;
+                std::memcpy(&x, reinterpret_cast<const char*>(&__a.lanes) + i, sizeof(x));
+                std::memcpy(&y, reinterpret_cast<const char*>(&__b.lanes) + i, sizeof(y));
+
+                x = _mm_mul_epu32(x, y);
+                std::memcpy(reinterpret_cast<char*>(&r.lanes) + i, &x, sizeof(x));
+            }
+
+            return r;
+        }
+#endif
+        return {(__a.lanes & 0xffffffff) * (__b.lanes & 0xffffffff)};
+    }
+
+    /**
+     * @returns t 2^-32 mod m per lane, for t < m 2^32
+     */
+    [[nodiscard]] static hash_type
+    _S_redc(const hash_type& __t) noexcept
+    {
+        const hash_type u = _S_mul32(__t, _S_minv);
+        return _S_reduce({(__t.lanes + _S_mul32(u, _S_mod).lanes) >> 32});
+    }
+
+    /**
+     * @returns a b 2^-32 mod m per lane, for a b < m 2^32 (a, b < m, or a < 2^32 and b < m)
+     */
+    [[nodiscard]] static hash_type
+    _S_mont(const hash_type& __a, const hash_type& __b) noexcept
+    { return _S_redc(_S_mul32(__a, __b)); }
+
+    container_type _M_h;
+    container_type _M_pw;
+};
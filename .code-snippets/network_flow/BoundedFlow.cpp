@@ -0,0 +1,350 @@
+/**
+ * @brief Flow with lower bounds by the super source / super sink reduction, on top of a flow engine
+ * (Dinic, Hlpp, SpfaDinic, PrimalDual, ...).
+ *
+ * Everything lives in one engine with two extra vertices, n and n + 1, for the super source and super sink. Next to
+ * the user's edges it holds at most one super source and one super sink edge per vertex and one t -> s edge per
+ * (s, t) pair queried, all added on first use. Every query restore()s the engine and sets the capacities of those
+ * extra edges through increase_capacity() / decrease_capacity(), so queries are independent and can be mixed
+ * freely on one object, without copying the graph.
+ * Engines without max_flow() (SpfaDinic, PrimalDual) answer the plain flow queries through min_cost_max_flow().
+ * With a cost engine, edges whose cost is negative under @p _Comp are added pre-saturated (reversed, with the cost
+ * negated), so negative cycles are fine.
+ */
+template<typename _Engine = Dinic<>, typename _Comp = std::ranges::less>
+class BoundedFlow
+{
+public:
+
+    using size_type = int;
+    using engine_type = _Engine;
+    using capacity_type = typename _Engine::capacity_type;
+
+private:
+
+    template<typename _E>
+    struct _CostOf
+    { using type = capacity_type; };
+
+    template<typename _E>
+    requires requires { typename _E::cost_type; }
+    struct _CostOf<_E>
+    { using type = typename _E::cost_type; };
+
+public:
+
+    /**
+     * @c capacity_type for plain max-flow engines
+     */
+    using cost_type = typename _CostOf<_Engine>::type;
+
+    static constexpr capacity_type inf = std::numeric_limits<capacity_type>::max();
+
+    explicit
+    BoundedFlow(size_type __n) : _M_engine(__n + 2), _M_balance(__n), _M_supply(__n), _M_demand(__n)
+    { }
+
+    /**
+     * @brief Edge carrying between @p __low and @p __high units.
+     */
+    void
+    add_edge(size_type __from, size_type __to, capacity_type __low, capacity_type __high)
+    {
+        _M_add_plain_edge(__from, __to, __high - __low);
+
+        _M_balance[__from] -= __low;
+        _M_balance[__to] += __low;
+    }
+
+    /**
+     * @brief Edge carrying between @p __low and @p __high units at @p __cost each.
+     */
+    void
+    add_edge(size_type __from, size_type __to, capacity_type __low, capacity_type __high, cost_type __cost)
+    {
+        // Costs are negated for max cost, so the engine always minimises.
+        if (_S_negate())
+        {
+            __cost = -__cost;
+        }
+
+        if (__cost < cost_type{})
+        {
+            // Start from the upper bound and let the engine push flow back at cost -c.
+            _M_engine.add_edge(__to, __from, __high - __low, -__cost);
+            _M_base_cost += cost_type(__high) * __cost;
+
+            _M_balance[__from] -= __high;
+            _M_balance[__to] += __high;
+        }
+        else
+        {
+            _M_engine.add_edge(__from, __to, __high - __low, __cost);
+            _M_base_cost += cost_type(__low) * __cost;
+
+            _M_balance[__from] -= __low;
+            _M_balance[__to] += __low;
+        }
+    }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return size_type(_M_balance.size()); }
+
+    /**
+     * @returns whether a circulation meeting all bounds exists
+     */
+    [[nodiscard]] bool
+    feasible()
+    {
+        _M_prepare(npos, npos);
+        return _M_saturate();
+    }
+
+    /**
+     * @returns max flow from @p __source to @p __sink meeting all bounds, or std::nullopt if there is none
+     */
+    [[nodiscard]] std::optional<capacity_type>
+    max_flow(size_type __source, size_type __sink)
+    {
+        _M_prepare(__source, __sink);
+
+        if (not _M_saturate())
+        {
+            return std::nullopt;
+        }
+
+        // The reverse of t -> s holds the feasible flow, so this picks it up together with the extra flow.
+        return _M_run_max_flow(__source, __sink);
+    }
+
+    /**
+     * @returns min flow from @p __source to @p __sink meeting all bounds, or std::nullopt if there is none
+     */
+    [[nodiscard]] std::optional<capacity_type>
+    min_flow(size_type __source, size_type __sink)
+    {
+        _BackEdge& back = *_M_prepare(__source, __sink);
+
+        if (not _M_saturate())
+        {
+            return std::nullopt;
+        }
+
+        // Freeze the feasible flow f on t -> s by closing its residual capacity, then push back as much as possible
+        // from t to s. Only edges are removed, so a min-cost residual graph keeps having no negative cycle.
+        const capacity_type open = _M_engine.residual_capacity(back.id);
+        const capacity_type f = inf - open;
+
+        _M_engine.decrease_capacity(back.id, open);
+        back.cap = f;
+
+        // Edges from t to s may carry it below 0, and feasible flow values form an interval holding f, so 0 is one.
+        return std::max(f - _M_run_max_flow(__sink, __source), capacity_type{});
+    }
+
+    /**
+     * @returns cost of the cheapest (most expensive for std::ranges::greater) circulation meeting all bounds,
+     * or std::nullopt if there is none
+     */
+    [[nodiscard]] std::optional<cost_type>
+    min_cost_feasible_flow()
+    {
+        _M_prepare(npos, npos);
+        return _M_min_cost_feasible_flow();
+    }
+
+    /**
+     * @brief Same as min_cost_feasible_flow(), with any amount of flow from @p __source to @p __sink.
+     */
+    [[nodiscard]] std::optional<cost_type>
+    min_cost_feasible_flow(size_type __source, size_type __sink)
+    {
+        _M_prepare(__source, __sink);
+        return _M_min_cost_feasible_flow();
+    }
+
+    /**
+     * @returns the engine in the state left by the last query: the user's edges, plus the super source / sink and
+     * t -> s edges added so far
+     */
+    [[nodiscard]] engine_type&
+    engine() noexcept
+    { return _M_engine; }
+
+private:
+
+    static constexpr size_type npos = -1;
+
+    /**
+     * @brief Extra edge of the reduction, with the capacity last set through the engine.
+     */
+    struct _Aux
+    {
+        size_type id = npos;
+        capacity_type cap{};
+    };
+
+    struct _BackEdge : _Aux
+    {
+        size_type source;
+        size_type sink;
+    };
+
+    [[nodiscard]] static constexpr bool
+    _S_negate() noexcept
+    { return _Comp{}(cost_type{1}, cost_type{}); }
+
+    size_type
+    _M_add_plain_edge(size_type __from, size_type __to, capacity_type __cap)
+    {
+        if constexpr (requires { typename _Engine::cost_type; })
+        {
+            return _M_engine.add_edge(__from, __to, __cap, typename _Engine::cost_type{});
+        }
+        else
+        {
+            return _M_engine.add_edge(__from, __to, __cap);
+        }
+    }
+
+    /**
+     * @brief Sets the capacity of an extra edge, adding it on first use. Only called right after restore().
+     */
+    void
+    _M_set(_Aux& __e, size_type __from, size_type __to, capacity_type __cap)
+    {
+        if (__e.id == npos)
+        {
+            if (__cap == capacity_type{})
+            {
+                return;
+            }
+
+            __e.id = _M_add_plain_edge(__from, __to, capacity_type{});
+        }
+
+        if (__cap > __e.cap)
+        {
+            _M_engine.increase_capacity(__e.id, __cap - __e.cap);
+        }
+        else if (__cap < __e.cap)
+        {
+            _M_engine.decrease_capacity(__e.id, __e.cap - __cap);
+        }
+
+        __e.cap = __cap;
+    }
+
+    /**
+     * @brief Restores the engine, sets the supply edges from the balances and opens only the t -> s edge of
+     * (@p __source, @p __sink), if any.
+     *
+     * @returns that t -> s edge, or nullptr
+     */
+    _BackEdge*
+    _M_prepare(size_type __source, size_type __sink)
+    {
+        _M_engine.restore();
+
+        const size_type ss = size(), tt = size() + 1;
+
+        for (size_type v = 0; v < size(); ++v)
+        {
+            _M_set(_M_supply[v], ss, v, std::max(_M_balance[v], capacity_type{}));
+            _M_set(_M_demand[v], v, tt, std::max(-_M_balance[v], capacity_type{}));
+        }
+
+        _BackEdge* open = nullptr;
+
+        for (_BackEdge& b : _M_back)
+        {
+            const bool match = b.source == __source and b.sink == __sink;
+            _M_set(b, b.sink, b.source, match ? inf : capacity_type{});
+
+            if (match)
+            {
+                open = &b;
+            }
+        }
+
+        if (open == nullptr and __source != npos)
+        {
+            open = &_M_back.emplace_back(_Aux{}, __source, __sink);
+            _M_set(*open, __sink, __source, inf);
+        }
+
+        return open;
+    }
+
+    [[nodiscard]] capacity_type
+    _M_supply_total() const
+    {
+        capacity_type need{};
+
+        for (const capacity_type b : _M_balance)
+        {
+            if (b > capacity_type{})
+            {
+                need += b;
+            }
+        }
+
+        return need;
+    }
+
+    /**
+     * @returns flow added to the engine by max_flow(), or min_cost_max_flow() for engines without it
+     */
+    capacity_type
+    _M_run_max_flow(size_type __source, size_type __sink)
+    {
+        const capacity_type before = _M_engine.current_flow();
+
+        if constexpr (requires { _M_engine.max_flow(__source, __sink); })
+        {
+            _M_engine.max_flow(__source, __sink);
+        }
+        else
+        {
+            _M_engine.min_cost_max_flow(__source, __sink);
+        }
+
+        return _M_engine.current_flow() - before;
+    }
+
+    /**
+     * @returns whether every lower bound can be met
+     */
+    bool
+    _M_saturate()
+    { return _M_run_max_flow(size(), size() + 1) == _M_supply_total(); }
+
+    std::optional<cost_type>
+    _M_min_cost_feasible_flow()
+    {
+        _M_engine.min_cost_max_flow(size(), size() + 1);
+
+        if (_M_engine.current_flow() != _M_supply_total())
+        {
+            return std::nullopt;
+        }
+
+        const cost_type cost = _M_base_cost + _M_engine.current_cost();
+        return _S_negate() ? -cost : cost;
+    }
+
+    engine_type _M_engine;
+
+    std::vector<capacity_type> _M_balance;
+
+    // super source -> v and v -> super sink edges
+    std::vector<_Aux> _M_supply;
+    std::vector<_Aux> _M_demand;
+
+    // t -> s edges, one per (s, t) pair queried
+    std::vector<_BackEdge> _M_back;
+
+    // sum of cost * (flow forced by the lower bounds or pre-saturation), in the engine's minimising sign
+    cost_type _M_base_cost{};
+};
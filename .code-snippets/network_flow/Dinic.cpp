@@ -6,6 +6,9 @@ public:
     using size_type = int;
     using capacity_type = _CapacityT;
 
+    /**
+     * @c rid is the index of the reverse edge in edges(to), with @c rid_mask set on forward edges.
+     */
     struct edge
     {
         size_type to;
@@ -14,52 +17,179 @@ public:
         capacity_type cap;
     };
 
+    struct cut_type
+    {
+        capacity_type value;
+
+        std::vector<bool> source_side;
+        std::vector<size_type> edges;
+    };
+
     static constexpr size_type rid_mask = size_type{1} << sizeof(size_type) * 8 - 1;
 
     explicit
-    Dinic(size_type __n = 0) : _M_e(__n), _M_cg(__n), _M_cur(__n)
+    Dinic(size_type __n = 0) : _M_start(__n + 1), _M_deg(__n), _M_cg(__n), _M_cur(__n)
     { }
 
-    void
+    /**
+     * @returns id for increase_capacity() / decrease_capacity()
+     * @note May be called after max_flow(); the next call only adds the extra flow.
+     */
+    size_type
     add_edge(size_type __from, size_type __to, capacity_type __cap)
     {
-        _M_e[__from].emplace_back(__to, size_type(_M_e[__to].size()) | rid_mask, __cap);
-        _M_e[__to].emplace_back(__from, size_type(_M_e[__from].size()) - 1, capacity_type{});
+        const size_type fid = _M_deg[__from]++;
+        const size_type tid = _M_deg[__to]++;
+
+        _M_pending.emplace_back(__from, fid, edge{__to, tid | rid_mask, __cap});
+        _M_pending.emplace_back(__to, tid, edge{__from, fid, capacity_type{}});
+
+        _M_ids.emplace_back(__from, fid);
+        return size_type(_M_ids.size()) - 1;
+    }
+
+    /**
+     * @brief Raises the capacity of edge @p __id, the next max_flow() picks up the extra flow.
+     */
+    void
+    increase_capacity(size_type __id, capacity_type __delta)
+    { _M_forward(__id).cap += __delta; }
+
+    /**
+     * @brief Lowers the capacity of edge @p __id by @p __delta (at most its capacity).
+     *
+     * Flow above the new capacity is first rerouted from the tail to the head of the edge,
+     * whatever cannot be rerouted is sent back to the source and from the sink of the last max_flow(),
+     * so the residual graph stays a valid flow and current_flow() drops by that amount.
+     *
+     * @returns the amount of flow that was cancelled
+     */
+    capacity_type
+    decrease_capacity(size_type __id, capacity_type __delta)
+    {
+        edge& i = _M_forward(__id);
+
+        if (i.cap >= __delta)
+        {
+            i.cap -= __delta;
+            return capacity_type{};
+        }
+
+        const capacity_type excess = __delta - i.cap;
+        const size_type u = _M_reverse(i).to;
+        const size_type v = i.to;
+
+        i.cap = capacity_type{};
+        _M_reverse(i).cap -= excess;
+
+        const capacity_type cancelled = excess - _M_limited_flow(u, v, excess);
+
+        if (cancelled)
+        {
+            _M_limited_flow(u, _M_source, cancelled);
+            _M_limited_flow(_M_sink, v, cancelled);
+
+            _M_flow -= cancelled;
+        }
+
+        return cancelled;
+    }
+
+    /**
+     * @returns residual capacity of edge @p __id
+     */
+    [[nodiscard]] capacity_type
+    residual_capacity(size_type __id)
+    { return _M_forward(__id).cap; }
+
+    /**
+     * @brief Packs all edges added so far into one contiguous array.
+     *
+     * Called by max_flow() automatically; edges added later are merged in by the next call.
+     */
+    void
+    finalize()
+    {
+        if (_M_pending.empty())
+        {
+            return;
+        }
+
+        std::vector<size_type> start(size() + 1);
+
+        for (size_type i = 0; i < size(); ++i)
+        {
+            start[i + 1] = start[i] + _M_deg[i];
+        }
+
+        std::vector<edge> e(start.back());
+
+        for (size_type i = 0; i < size(); ++i)
+        {
+            std::ranges::copy(edges(i), e.begin() + start[i]);
+        }
+
+        for (const auto& [from, id, i] : _M_pending)
+        {
+            e[start[from] + id] = i;
+        }
+
+        _M_e = std::move(e);
+        _M_start = std::move(start);
+
+        _M_pending.clear();
+        _M_pending.shrink_to_fit();
     }
 
     [[nodiscard]] size_type
     size() const noexcept
-    { return size_type(_M_e.size()); }
+    { return size_type(_M_deg.size()); }
 
-    [[nodiscard]] const std::vector<edge>&
+    /**
+     * @note Edges added after the last finalize() / max_flow() are not visible yet.
+     */
+    [[nodiscard]] std::span<const edge>
     edges(size_type __i) const
-    { return _M_e[__i]; }
+    { return {_M_e.begin() + _M_start[__i], _M_e.begin() + _M_start[__i + 1]}; }
 
     [[nodiscard]] capacity_type
     current_flow() const noexcept
     { return _M_flow; }
 
+    /**
+     * @note The BFS stops as soon as @p __sink is labelled, vertices further away are left unreachable.
+     */
     size_type
     build_level_graph(size_type __source, size_type __sink)
     {
+        finalize();
+
         _M_cg.assign(_M_cg.size(), std::numeric_limits<size_type>::max());
-        _M_cur.assign(_M_cur.size(), size_type{});
+        std::ranges::copy(_M_start | std::views::take(size()), _M_cur.begin());
 
-        std::queue<size_type> que;
-        que.push(__source);
+        std::vector<size_type>& que = _M_que;
+        que.clear();
+        que.push_back(__source);
         _M_cg[__source] = size_type{};
 
-        while (not que.empty())
+        for (size_type qi = 0; qi < size_type(que.size()); ++qi)
         {
-            const auto u = que.front();
-            que.pop();
+            const auto u = que[qi];
 
-            for (const edge& i : _M_e[u])
+            for (size_type j = _M_start[u]; j < _M_start[u + 1]; ++j)
             {
+                const edge& i = _M_e[j];
+
                 if (i.cap and _M_cg[i.to] == std::numeric_limits<size_type>::max())
                 {
                     _M_cg[i.to] = _M_cg[u] + 1;
-                    que.push(i.to);
+
+                    if (i.to == __sink)
+                    {
+                        return _M_cg[__sink];
+                    }
+
+                    que.push_back(i.to);
                 }
             }
         }
@@ -67,41 +197,99 @@ public:
         return _M_cg[__sink];
     }
 
+    /**
+     * @brief Saturates the current level graph (blocking flow).
+     *
+     * @returns flow added, 0 when @p __source == @p __sink
+     */
     capacity_type
     augment_flow(size_type __source, size_type __sink)
     {
-        const auto flow = _M_augment_flow(__source, __sink, std::numeric_limits<capacity_type>::max());
+        if (__source == __sink)
+        {
+            return capacity_type{};
+        }
+
+        const auto flow = _M_blocking_flow(__source, __sink, std::numeric_limits<capacity_type>::max());
         _M_flow += flow;
         return flow;
     }
 
+    /**
+     * @brief Resumes from the current residual graph, so after add_edge() / increase_capacity()
+     * only the extra flow is searched for.
+     *
+     * @returns flow added by this call, current_flow() holds the total
+     */
     capacity_type
     max_flow(size_type __source, size_type __sink)
     {
+        _M_source = __source;
+        _M_sink = __sink;
+
+        if (__source == __sink)
+        {
+            return capacity_type{};
+        }
+
+        const capacity_type flow = _M_flow;
+
         while (build_level_graph(__source, __sink) != std::numeric_limits<size_type>::max())
         {
-            while (augment_flow(__source, __sink));
+            augment_flow(__source, __sink);
         }
 
-        return _M_flow;
+        return _M_flow - flow;
     }
 
     capacity_type
     min_cut(size_type __source, size_type __sink)
-    { return max_flow(__source, __sink); }
+    { return max_flow(__source, __sink), _M_flow; }
+
+    /**
+     * @brief Finishes max_flow() and reads the cut off its last, sink-missing residual BFS.
+     *
+     * @returns cut value, vertices reachable from @p __source, and ids of the saturated edges leaving them
+     * @note @p __source must differ from @p __sink.
+     */
+    cut_type
+    min_cut_partition(size_type __source, size_type __sink)
+    {
+        max_flow(__source, __sink);
+
+        cut_type cut{_M_flow, std::vector<bool>(size()), {}};
+
+        for (size_type i = 0; i < size(); ++i)
+        {
+            cut.source_side[i] = _M_cg[i] != std::numeric_limits<size_type>::max();
+        }
+
+        for (size_type id = 0; id < size_type(_M_ids.size()); ++id)
+        {
+            const auto [from, fid] = _M_ids[id];
+
+            if (cut.source_side[from] and not cut.source_side[_M_e[_M_start[from] + fid].to])
+            {
+                cut.edges.push_back(id);
+            }
+        }
+
+        return cut;
+    }
 
     void
     restore()
     {
-        for (std::vector<edge>& es : _M_e)
+        finalize();
+
+        for (edge& i : _M_e)
         {
-            for (edge& i : es)
+            if (i.rid & rid_mask)
             {
-                if (i.rid & rid_mask)
-                {
-                    i.cap += _M_e[i.to][i.rid ^ rid_mask].cap;
-                    _M_e[i.to][i.rid ^ rid_mask].cap = 0;
-                }
+                edge& r = _M_reverse(i);
+
+                i.cap += r.cap;
+                r.cap = 0;
             }
         }
 
@@ -111,7 +299,10 @@ public:
     void
     resize(size_type __n)
     {
-        _M_e.resize(__n);
+        finalize();
+
+        _M_start.resize(__n + 1, _M_start.back());
+        _M_deg.resize(__n);
         _M_cg.resize(__n);
         _M_cur.resize(__n);
     }
@@ -119,50 +310,153 @@ public:
     void
     reset()
     {
-        for (std::vector<edge>& i : _M_e)
-        {
-            i.clear();
-        }
+        _M_e.clear();
+        _M_pending.clear();
+        _M_ids.clear();
+
+        std::ranges::fill(_M_start, size_type{});
+        std::ranges::fill(_M_deg, size_type{});
 
         _M_flow = capacity_type{};
     }
 
 private:
 
+    [[nodiscard]] edge&
+    _M_reverse(const edge& __i)
+    { return _M_e[_M_start[__i.to] + (__i.rid & ~rid_mask)]; }
+
+    [[nodiscard]] edge&
+    _M_forward(size_type __id)
+    {
+        finalize();
+
+        const auto [from, fid] = _M_ids[__id];
+        return _M_e[_M_start[from] + fid];
+    }
+
+    /**
+     * @brief Pushes at most @p __limit from @p __source to @p __sink, leaving current_flow() alone.
+     */
     capacity_type
-    _M_augment_flow(size_type __u, size_type __sink, capacity_type __limit)
+    _M_limited_flow(size_type __source, size_type __sink, capacity_type __limit)
     {
-        if (__u == __sink)
+        if (__source == __sink)
         {
             return __limit;
         }
 
-        while (_M_cur[__u] < size_type(_M_e[__u].size()))
+        capacity_type total{};
+
+        while (total < __limit and build_level_graph(__source, __sink) != std::numeric_limits<size_type>::max())
         {
-            edge& i = _M_e[__u][_M_cur[__u]];
-            ++_M_cur[__u];
+            total += _M_blocking_flow(__source, __sink, __limit - total);
+        }
+
+        return total;
+    }
 
-            if (_M_cg[__u] + 1 == _M_cg[i.to] and i.cap)
+    capacity_type
+    _M_blocking_flow(size_type __source, size_type __sink, capacity_type __limit)
+    {
+        constexpr auto unreachable = std::numeric_limits<size_type>::max();
+
+        capacity_type total{};
+
+        // edge indices of the current source -> u path
+        std::vector<size_type>& path = _M_path;
+        path.clear();
+
+        for (size_type u = __source; ; )
+        {
+            if (u == __sink)
             {
-                if (const auto flow = _M_augment_flow(i.to, __sink, std::min(__limit, i.cap)); flow)
+                capacity_type flow = __limit - total;
+
+                for (const size_type j : path)
                 {
+                    flow = std::min(flow, _M_e[j].cap);
+                }
+
+                size_type first_saturated = size_type(path.size());
+
+                for (size_type k = size_type(path.size()); k--; )
+                {
+                    edge& i = _M_e[path[k]];
+
                     i.cap -= flow;
-                    _M_e[i.to][i.rid & ~rid_mask].cap += flow;
+                    _M_reverse(i).cap += flow;
+
+                    if (not i.cap)
+                    {
+                        first_saturated = k;
+                    }
+                }
+
+                total += flow;
+
+                if (total == __limit)
+                {
+                    break;
+                }
+
+                // Retreat to the tail of the first saturated edge and keep pushing from there.
+                u = _M_reverse(_M_e[path[first_saturated]]).to;
+                path.resize(first_saturated);
+
+                continue;
+            }
+
+            for (; _M_cur[u] < _M_start[u + 1]; ++_M_cur[u])
+            {
+                const edge& i = _M_e[_M_cur[u]];
 
-                    return flow;
+                if (i.cap and _M_cg[u] + 1 == _M_cg[i.to])
+                {
+                    break;
                 }
+            }
 
-                _M_cg[i.to] = std::numeric_limits<size_type>::max();
+            if (_M_cur[u] < _M_start[u + 1])
+            {
+                path.push_back(_M_cur[u]);
+                u = _M_e[_M_cur[u]].to;
+            }
+            else if (path.empty())
+            {
+                break;
+            }
+            else
+            {
+                _M_cg[u] = unreachable;
+
+                u = _M_reverse(_M_e[path.back()]).to;
+                path.pop_back();
+
+                ++_M_cur[u];
             }
         }
 
-        return capacity_type{};
+        return total;
     }
 
-    std::vector<std::vector<edge>> _M_e;
-    std::vector<size_type> _M_cg;
+    // CSR: edges of u are _M_e[_M_start[u], _M_start[u + 1])
+    std::vector<edge> _M_e;
+    std::vector<size_type> _M_start;
+
+    std::vector<size_type> _M_deg;
+    std::vector<std::tuple<size_type, size_type, edge>> _M_pending;
 
+    // edge id -> (from, index in edges(from))
+    std::vector<std::pair<size_type, size_type>> _M_ids;
+
+    std::vector<size_type> _M_cg;
     std::vector<size_type> _M_cur;
+    std::vector<size_type> _M_que;
+    std::vector<size_type> _M_path;
 
     capacity_type _M_flow{};
+
+    size_type _M_source = 0;
+    size_type _M_sink = 0;
 };
\ No newline at end of file
@@ -0,0 +1,170 @@
+/**
+ * @brief Gomory-Hu tree of an undirected graph by Gusfield's algorithm: n - 1 max-flow calls on one Dinic,
+ * restore()d between calls, with no vertex contraction.
+ *
+ * The min cut between u and v is the lightest edge on their tree path.
+ * build(threads) runs the calls speculatively on @p threads copies of the network; a result is kept only if
+ * the tree parent it was computed against has not changed by the time it is committed, so the tree is the same
+ * as the sequential one.
+ */
+template<typename _CapacityT = int>
+class GomoryHuTree
+{
+public:
+
+    using size_type = int;
+    using capacity_type = _CapacityT;
+
+    explicit
+    GomoryHuTree(size_type __n = 0) : _M_net(__n), _M_parent(__n, -1), _M_weight(__n), _M_depth(__n)
+    { }
+
+    void
+    add_edge(size_type __u, size_type __v, capacity_type __cap)
+    {
+        _M_net.add_edge(__u, __v, __cap);
+        _M_net.add_edge(__v, __u, __cap);
+    }
+
+    void
+    build(size_type __threads = 1)
+    {
+        const size_type n = size();
+
+        if (n == 0)
+        {
+            return;
+        }
+
+        std::ranges::fill(_M_parent, size_type{});
+        _M_parent[0] = -1;
+
+        _M_net.finalize();
+
+        if (__threads <= 1)
+        {
+            for (size_type s = 1; s < n; ++s)
+            {
+                _M_net.restore();
+                _M_commit(s, _M_net.min_cut_partition(s, _M_parent[s]));
+            }
+        }
+        else
+        {
+            _M_build_parallel(__threads);
+        }
+
+        _M_depth[0] = 0;
+        _M_weight[0] = capacity_type{};
+
+        // parent(v) < v
+        for (size_type v = 1; v < n; ++v)
+        {
+            _M_depth[v] = _M_depth[_M_parent[v]] + 1;
+        }
+    }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return _M_net.size(); }
+
+    /**
+     * @returns tree parent of @p __v, -1 for vertex 0
+     */
+    [[nodiscard]] size_type
+    parent(size_type __v) const
+    { return _M_parent[__v]; }
+
+    /**
+     * @returns min cut between @p __v and parent(v)
+     */
+    [[nodiscard]] capacity_type
+    weight(size_type __v) const
+    { return _M_weight[__v]; }
+
+    /**
+     * @returns min cut between @p __u and @p __v, O(tree path)
+     */
+    [[nodiscard]] capacity_type
+    min_cut(size_type __u, size_type __v) const
+    {
+        capacity_type cut = std::numeric_limits<capacity_type>::max();
+
+        while (__u != __v)
+        {
+            if (_M_depth[__u] < _M_depth[__v])
+            {
+                std::swap(__u, __v);
+            }
+
+            cut = std::min(cut, _M_weight[__u]);
+            __u = _M_parent[__u];
+        }
+
+        return cut;
+    }
+
+private:
+
+    using cut_type = typename Dinic<capacity_type>::cut_type;
+
+    void
+    _M_commit(size_type __s, const cut_type& __cut)
+    {
+        const size_type t = _M_parent[__s];
+        _M_weight[__s] = __cut.value;
+
+        for (size_type i = __s + 1; i < size(); ++i)
+        {
+            if (_M_parent[i] == t and __cut.source_side[i])
+            {
+                _M_parent[i] = __s;
+            }
+        }
+    }
+
+    void
+    _M_build_parallel(size_type __threads)
+    {
+        const size_type n = size();
+
+        std::vector<Dinic<capacity_type>> nets(__threads, _M_net);
+        std::vector<cut_type> cuts(__threads);
+        std::vector<size_type> sinks(__threads);
+
+        for (size_type s = 1; s < n; )
+        {
+            const size_type batch = std::min(__threads, n - s);
+
+            std::vector<std::thread> workers;
+            workers.reserve(batch);
+
+            for (size_type k = 0; k < batch; ++k)
+            {
+                sinks[k] = _M_parent[s + k];
+
+                workers.emplace_back([&, k]() -> void {
+                    nets[k].restore();
+                    cuts[k] = nets[k].min_cut_partition(s + k, sinks[k]);
+                });
+            }
+
+            for (std::thread& w : workers)
+            {
+                w.join();
+            }
+
+            // A speculative cut is only valid if its sink is still the tree parent.
+            for (size_type k = 0; k < batch and _M_parent[s] == sinks[k]; ++k, ++s)
+            {
+                _M_commit(s, cuts[k]);
+            }
+        }
+    }
+
+    Dinic<capacity_type> _M_net;
+
+    std::vector<size_type> _M_parent;
+    std::vector<capacity_type> _M_weight;
+    std::vector<size_type> _M_depth;
+};
@@ -0,0 +1,505 @@
+/**
+ * @brief Highest-label push-relabel with global relabeling and the gap heuristic, O(n² √m).
+ *
+ * Same interface as Dinic.
+ */
+template<typename _CapacityT = int>
+class Hlpp
+{
+public:
+
+    using size_type = int;
+    using capacity_type = _CapacityT;
+
+    /**
+     * @c rid is the index of the reverse edge in edges(to), with @c rid_mask set on forward edges.
+     */
+    struct edge
+    {
+        size_type to;
+        size_type rid;
+
+        capacity_type cap;
+    };
+
+    static constexpr size_type rid_mask = size_type{1} << sizeof(size_type) * 8 - 1;
+
+    explicit
+    Hlpp(size_type __n = 0) : _M_start(__n + 1), _M_deg(__n)
+    { }
+
+    /**
+     * @returns id for increase_capacity() / decrease_capacity()
+     */
+    size_type
+    add_edge(size_type __from, size_type __to, capacity_type __cap)
+    {
+        const size_type fid = _M_deg[__from]++;
+        const size_type tid = _M_deg[__to]++;
+
+        _M_pending.emplace_back(__from, fid, edge{__to, tid | rid_mask, __cap});
+        _M_pending.emplace_back(__to, tid, edge{__from, fid, capacity_type{}});
+
+        _M_ids.emplace_back(__from, fid);
+        return size_type(_M_ids.size()) - 1;
+    }
+
+    /**
+     * @brief Raises the capacity of edge @p __id, the next max_flow() picks up the extra flow.
+     */
+    void
+    increase_capacity(size_type __id, capacity_type __delta)
+    { _M_forward(__id).cap += __delta; }
+
+    /**
+     * @brief Lowers the residual capacity of edge @p __id by @p __delta, which must not exceed it (after restore(),
+     * the capacity itself). Unlike Dinic::decrease_capacity(), flow through the edge is never cancelled.
+     */
+    void
+    decrease_capacity(size_type __id, capacity_type __delta)
+    { _M_forward(__id).cap -= __delta; }
+
+    /**
+     * @returns residual capacity of edge @p __id
+     */
+    [[nodiscard]] capacity_type
+    residual_capacity(size_type __id)
+    { return _M_forward(__id).cap; }
+
+    /**
+     * @brief Packs all edges added so far into one contiguous array.
+     *
+     * Called by max_flow() automatically; edges added later are merged in by the next call.
+     */
+    void
+    finalize()
+    {
+        if (_M_pending.empty())
+        {
+            return;
+        }
+
+        std::vector<size_type> start(size() + 1);
+
+        for (size_type i = 0; i < size(); ++i)
+        {
+            start[i + 1] = start[i] + _M_deg[i];
+        }
+
+        std::vector<edge> e(start.back());
+
+        for (size_type i = 0; i < size(); ++i)
+        {
+            std::ranges::copy(edges(i), e.begin() + start[i]);
+        }
+
+        for (const auto& [from, id, i] : _M_pending)
+        {
+            e[start[from] + id] = i;
+        }
+
+        _M_e = std::move(e);
+        _M_start = std::move(start);
+
+        _M_pending.clear();
+        _M_pending.shrink_to_fit();
+    }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return size_type(_M_deg.size()); }
+
+    /**
+     * @note Edges added after the last finalize() / max_flow() are not visible yet.
+     */
+    [[nodiscard]] std::span<const edge>
+    edges(size_type __i) const
+    { return {_M_e.begin() + _M_start[__i], _M_e.begin() + _M_start[__i + 1]}; }
+
+    [[nodiscard]] capacity_type
+    current_flow() const noexcept
+    { return _M_flow; }
+
+    /**
+     * @brief Resumes from the current residual graph, like Dinic::max_flow().
+     *
+     * @returns flow added by this call, current_flow() holds the total
+     */
+    capacity_type
+    max_flow(size_type __source, size_type __sink)
+    {
+        finalize();
+
+        if (__source == __sink)
+        {
+            return capacity_type{};
+        }
+
+        const size_type n = size();
+
+        _M_source = __source;
+        _M_sink = __sink;
+
+        _M_ex.assign(n, capacity_type{});
+        _M_h.assign(n, size_type{});
+        _M_cur.assign(_M_start.begin(), _M_start.end() - 1);
+
+        _M_active.assign(n * 2, {});
+        _M_head.assign(n, -1);
+        _M_prev.assign(n, -1);
+        _M_next.assign(n, -1);
+
+        for (size_type j = _M_start[__source]; j < _M_start[__source + 1]; ++j)
+        {
+            if (edge& i = _M_e[j]; i.cap)
+            {
+                _M_ex[i.to] += i.cap;
+                _M_reverse(i).cap += i.cap;
+                i.cap = 0;
+            }
+        }
+
+        _M_global_relabel();
+
+        const size_type relabel_threshold = n * 6 + size_type(_M_e.size());
+
+        for (size_type work = 0; _M_highest >= 0; )
+        {
+            if (_M_active[_M_highest].empty())
+            {
+                --_M_highest;
+                continue;
+            }
+
+            const size_type u = _M_active[_M_highest].back();
+            _M_active[_M_highest].pop_back();
+
+            // Lifted by a gap after it was queued.
+            if (_M_h[u] != _M_highest)
+            {
+                _M_activate(u);
+                continue;
+            }
+
+            work += _M_discharge(u);
+
+            if (work > relabel_threshold)
+            {
+                work = 0;
+                _M_global_relabel();
+            }
+        }
+
+        _M_flow += _M_ex[__sink];
+        return _M_ex[__sink];
+    }
+
+    capacity_type
+    min_cut(size_type __source, size_type __sink)
+    { return max_flow(__source, __sink), _M_flow; }
+
+    void
+    restore()
+    {
+        finalize();
+
+        for (edge& i : _M_e)
+        {
+            if (i.rid & rid_mask)
+            {
+                edge& r = _M_reverse(i);
+
+                i.cap += r.cap;
+                r.cap = 0;
+            }
+        }
+
+        _M_flow = capacity_type{};
+    }
+
+    void
+    resize(size_type __n)
+    {
+        finalize();
+
+        _M_start.resize(__n + 1, _M_start.back());
+        _M_deg.resize(__n);
+    }
+
+    void
+    reset()
+    {
+        _M_e.clear();
+        _M_pending.clear();
+        _M_ids.clear();
+
+        std::ranges::fill(_M_start, size_type{});
+        std::ranges::fill(_M_deg, size_type{});
+
+        _M_flow = capacity_type{};
+    }
+
+private:
+
+    [[nodiscard]] edge&
+    _M_reverse(const edge& __i)
+    { return _M_e[_M_start[__i.to] + (__i.rid & ~rid_mask)]; }
+
+    [[nodiscard]] edge&
+    _M_forward(size_type __id)
+    {
+        finalize();
+
+        const auto [from, fid] = _M_ids[__id];
+        return _M_e[_M_start[from] + fid];
+    }
+
+    void
+    _M_activate(size_type __u)
+    {
+        _M_active[_M_h[__u]].push_back(__u);
+        _M_highest = std::max(_M_highest, _M_h[__u]);
+    }
+
+    void
+    _M_link(size_type __u)
+    {
+        if (const size_type h = _M_h[__u]; h < size())
+        {
+            _M_prev[__u] = -1;
+            _M_next[__u] = _M_head[h];
+
+            if (_M_head[h] != -1)
+            {
+                _M_prev[_M_head[h]] = __u;
+            }
+
+            _M_head[h] = __u;
+            _M_max_height = std::max(_M_max_height, h);
+        }
+    }
+
+    void
+    _M_unlink(size_type __u)
+    {
+        if (const size_type h = _M_h[__u]; h < size())
+        {
+            if (_M_prev[__u] != -1)
+            {
+                _M_next[_M_prev[__u]] = _M_next[__u];
+            }
+            else
+            {
+                _M_head[h] = _M_next[__u];
+            }
+
+            if (_M_next[__u] != -1)
+            {
+                _M_prev[_M_next[__u]] = _M_prev[__u];
+            }
+        }
+    }
+
+    /**
+     * @brief Exact distances to the sink (or n + distance to the source) in the residual graph.
+     */
+    void
+    _M_global_relabel()
+    {
+        const size_type n = size();
+
+        _M_h.assign(n, n * 2);
+        std::ranges::fill(_M_head, -1);
+        _M_max_height = 0;
+
+        for (auto& i : _M_active)
+        {
+            i.clear();
+        }
+
+        _M_highest = -1;
+
+        std::vector<size_type>& que = _M_que;
+        que.clear();
+
+        auto bfs = [&](size_type __from, size_type __base) -> void
+        {
+            if (_M_h[__from] != n * 2)
+            {
+                return;
+            }
+
+            _M_h[__from] = __base;
+            que.push_back(__from);
+
+            for (size_type qi = size_type(que.size()) - 1; qi < size_type(que.size()); ++qi)
+            {
+                const size_type u = que[qi];
+
+                for (size_type j = _M_start[u]; j < _M_start[u + 1]; ++j)
+                {
+                    const edge& i = _M_e[j];
+
+                    if (_M_h[i.to] == n * 2 and _M_reverse(i).cap)
+                    {
+                        _M_h[i.to] = _M_h[u] + 1;
+                        que.push_back(i.to);
+                    }
+                }
+            }
+        };
+
+        bfs(_M_sink, 0);
+        _M_h[_M_source] = n * 2;
+        bfs(_M_source, n);
+
+        for (size_type u = 0; u < n; ++u)
+        {
+            _M_cur[u] = _M_start[u];
+
+            if (u != _M_source and u != _M_sink)
+            {
+                _M_link(u);
+
+                if (_M_ex[u] and _M_h[u] < n * 2)
+                {
+                    _M_activate(u);
+                }
+            }
+        }
+    }
+
+    /**
+     * @returns amount of work done, for scheduling global relabels
+     */
+    size_type
+    _M_discharge(size_type __u)
+    {
+        const size_type n = size();
+
+        size_type work = 0;
+
+        while (_M_ex[__u])
+        {
+            if (_M_cur[__u] == _M_start[__u + 1])
+            {
+                work += _M_start[__u + 1] - _M_start[__u] + 1;
+
+                if (not _M_relabel(__u))
+                {
+                    break;
+                }
+
+                continue;
+            }
+
+            edge& i = _M_e[_M_cur[__u]];
+
+            if (i.cap and _M_h[__u] == _M_h[i.to] + 1)
+            {
+                const capacity_type flow = std::min(_M_ex[__u], i.cap);
+
+                if (not _M_ex[i.to] and i.to != _M_source and i.to != _M_sink)
+                {
+                    _M_activate(i.to);
+                }
+
+                i.cap -= flow;
+                _M_reverse(i).cap += flow;
+
+                _M_ex[__u] -= flow;
+                _M_ex[i.to] += flow;
+            }
+            else
+            {
+                ++_M_cur[__u];
+            }
+        }
+
+        if (_M_ex[__u] and _M_h[__u] < n * 2)
+        {
+            _M_activate(__u);
+        }
+
+        return work;
+    }
+
+    /**
+     * @returns false if @p __u cannot push anywhere any more
+     */
+    bool
+    _M_relabel(size_type __u)
+    {
+        const size_type n = size();
+        const size_type old = _M_h[__u];
+
+        _M_unlink(__u);
+
+        if (old < n and _M_head[old] == -1)
+        {
+            // Gap: nothing at height old can reach the sink any more.
+            for (size_type h = old + 1; h <= _M_max_height; ++h)
+            {
+                for (size_type v = _M_head[h]; v != -1; v = _M_next[v])
+                {
+                    _M_h[v] = n + 1;
+                    _M_cur[v] = _M_start[v];
+                }
+
+                _M_head[h] = -1;
+            }
+
+            _M_max_height = old;
+            _M_h[__u] = n + 1;
+        }
+        else
+        {
+            size_type h = n * 2;
+
+            for (size_type j = _M_start[__u]; j < _M_start[__u + 1]; ++j)
+            {
+                if (_M_e[j].cap)
+                {
+                    h = std::min(h, _M_h[_M_e[j].to] + 1);
+                }
+            }
+
+            _M_h[__u] = h;
+            _M_link(__u);
+        }
+
+        _M_cur[__u] = _M_start[__u];
+
+        return _M_h[__u] < n * 2;
+    }
+
+    // CSR: edges of u are _M_e[_M_start[u], _M_start[u + 1])
+    std::vector<edge> _M_e;
+    std::vector<size_type> _M_start;
+
+    std::vector<size_type> _M_deg;
+    std::vector<std::tuple<size_type, size_type, edge>> _M_pending;
+
+    // edge id -> (from, index in edges(from))
+    std::vector<std::pair<size_type, size_type>> _M_ids;
+
+    size_type _M_source = 0;
+    size_type _M_sink = 0;
+
+    std::vector<capacity_type> _M_ex;
+    std::vector<size_type> _M_h;
+    std::vector<size_type> _M_cur;
+    std::vector<size_type> _M_que;
+
+    // active vertices by height
+    std::vector<std::vector<size_type>> _M_active;
+    size_type _M_highest = -1;
+
+    // all vertices below height n, by height, for the gap heuristic
+    std::vector<size_type> _M_head;
+    std::vector<size_type> _M_prev;
+    std::vector<size_type> _M_next;
+    size_type _M_max_height = 0;
+
+    capacity_type _M_flow{};
+};
\ No newline at end of file
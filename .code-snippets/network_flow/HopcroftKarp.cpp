@@ -0,0 +1,378 @@
+/**
+ * @brief Hopcroft-Karp maximum bipartite matching on CSR adjacency, O(E sqrt(V)).
+ *
+ * Left vertices are [0, left), right vertices are [0, right), each side numbered on its own.
+ * A greedy pass seeds the matching before the first phase.
+ */
+class HopcroftKarp
+{
+public:
+
+    using size_type = int;
+
+    static constexpr size_type npos = -1;
+
+    struct vertex_set
+    {
+        std::vector<size_type> left;
+        std::vector<size_type> right;
+    };
+
+    HopcroftKarp(size_type __left, size_type __right)
+        : _M_start(__left + 1), _M_deg(__left), _M_match_left(__left, npos), _M_match_right(__right, npos),
+          _M_dist(__left), _M_cur(__left)
+    { }
+
+    void
+    add_edge(size_type __u, size_type __v)
+    {
+        ++_M_deg[__u];
+        _M_pending.emplace_back(__u, __v);
+    }
+
+    /**
+     * @brief Packs all edges added so far into one contiguous array, called by max_matching() automatically.
+     */
+    void
+    finalize()
+    {
+        if (_M_pending.empty())
+        {
+            return;
+        }
+
+        std::vector<size_type> start(left_size() + 1);
+
+        for (size_type u = 0; u < left_size(); ++u)
+        {
+            start[u + 1] = start[u] + _M_deg[u];
+        }
+
+        std::vector<size_type> adj(start.back());
+        std::vector<size_type> pos(start.begin(), start.end() - 1);
+
+        for (size_type u = 0; u < left_size(); ++u)
+        {
+            pos[u] = std::ranges::copy(neighbors(u), adj.begin() + pos[u]).out - adj.begin();
+        }
+
+        for (const auto& [u, v] : _M_pending)
+        {
+            adj[pos[u]++] = v;
+        }
+
+        _M_adj = std::move(adj);
+        _M_start = std::move(start);
+
+        _M_pending.clear();
+        _M_pending.shrink_to_fit();
+    }
+
+    [[nodiscard]] size_type
+    left_size() const noexcept
+    { return size_type(_M_match_left.size()); }
+
+    [[nodiscard]] size_type
+    right_size() const noexcept
+    { return size_type(_M_match_right.size()); }
+
+    /**
+     * @note Edges added after the last finalize() / max_matching() are not visible yet.
+     */
+    [[nodiscard]] std::span<const size_type>
+    neighbors(size_type __u) const
+    { return {_M_adj.begin() + _M_start[__u], _M_adj.begin() + _M_start[__u + 1]}; }
+
+    /**
+     * @brief Extends the current matching, so edges may be added between calls.
+     *
+     * @returns size of the matching
+     */
+    size_type
+    max_matching()
+    {
+        finalize();
+
+        for (size_type u = 0; u < left_size(); ++u)
+        {
+            if (_M_match_left[u] != npos)
+            {
+                continue;
+            }
+
+            for (const size_type v : neighbors(u))
+            {
+                if (_M_match_right[v] == npos)
+                {
+                    _M_match(u, v);
+                    break;
+                }
+            }
+        }
+
+        while (_M_bfs())
+        {
+            std::ranges::copy(_M_start | std::views::take(left_size()), _M_cur.begin());
+
+            for (size_type u = 0; u < left_size(); ++u)
+            {
+                if (_M_match_left[u] == npos)
+                {
+                    _M_augment(u);
+                }
+            }
+        }
+
+        return _M_size;
+    }
+
+    [[nodiscard]] size_type
+    matching_size() const noexcept
+    { return _M_size; }
+
+    /**
+     * @returns right vertex matched with @p __u, or npos
+     */
+    [[nodiscard]] size_type
+    match_left(size_type __u) const
+    { return _M_match_left[__u]; }
+
+    /**
+     * @returns left vertex matched with @p __v, or npos
+     */
+    [[nodiscard]] size_type
+    match_right(size_type __v) const
+    { return _M_match_right[__v]; }
+
+    [[nodiscard]] std::vector<std::pair<size_type, size_type>>
+    matching() const
+    {
+        std::vector<std::pair<size_type, size_type>> res;
+        res.reserve(_M_size);
+
+        for (size_type u = 0; u < left_size(); ++u)
+        {
+            if (_M_match_left[u] != npos)
+            {
+                res.emplace_back(u, _M_match_left[u]);
+            }
+        }
+
+        return res;
+    }
+
+    /**
+     * @brief König: with Z the vertices reachable from free left vertices by alternating paths,
+     * the cover is (L \ Z) + (R & Z).
+     *
+     * @note Only minimum after max_matching().
+     */
+    [[nodiscard]] vertex_set
+    min_vertex_cover()
+    { return _M_konig(false); }
+
+    /**
+     * @brief Complement of min_vertex_cover(): (L & Z) + (R \ Z).
+     */
+    [[nodiscard]] vertex_set
+    max_independent_set()
+    { return _M_konig(true); }
+
+    void
+    reset()
+    {
+        _M_adj.clear();
+        _M_pending.clear();
+
+        std::ranges::fill(_M_start, size_type{});
+        std::ranges::fill(_M_deg, size_type{});
+        std::ranges::fill(_M_match_left, npos);
+        std::ranges::fill(_M_match_right, npos);
+
+        _M_size = 0;
+    }
+
+private:
+
+    static constexpr size_type unreachable = std::numeric_limits<size_type>::max();
+
+    void
+    _M_match(size_type __u, size_type __v)
+    {
+        _M_match_left[__u] = __v;
+        _M_match_right[__v] = __u;
+        ++_M_size;
+    }
+
+    /**
+     * @brief Layers left vertices by alternating distance from the free ones,
+     * stopping at the layer where a free right vertex first shows up.
+     *
+     * @returns whether an augmenting path exists
+     */
+    bool
+    _M_bfs()
+    {
+        std::vector<size_type>& que = _M_que;
+        que.clear();
+
+        for (size_type u = 0; u < left_size(); ++u)
+        {
+            if (_M_match_left[u] == npos)
+            {
+                _M_dist[u] = 0;
+                que.push_back(u);
+            }
+            else
+            {
+                _M_dist[u] = unreachable;
+            }
+        }
+
+        _M_limit = unreachable;
+
+        for (size_type qi = 0; qi < size_type(que.size()); ++qi)
+        {
+            const size_type u = que[qi];
+
+            if (_M_dist[u] >= _M_limit)
+            {
+                break;
+            }
+
+            for (const size_type v : neighbors(u))
+            {
+                const size_type w = _M_match_right[v];
+
+                if (w == npos)
+                {
+                    _M_limit = std::min(_M_limit, _M_dist[u]);
+                }
+                else if (_M_dist[w] == unreachable)
+                {
+                    _M_dist[w] = _M_dist[u] + 1;
+                    que.push_back(w);
+                }
+            }
+        }
+
+        return _M_limit != unreachable;
+    }
+
+    /**
+     * @brief Iterative DFS along the layers from free vertex @p __root, flipping the path if it reaches a free right vertex.
+     */
+    void
+    _M_augment(size_type __root)
+    {
+        // left vertices of the current path, _M_cur of each points at the edge taken
+        std::vector<size_type>& path = _M_path;
+        path.assign(1, __root);
+
+        while (not path.empty())
+        {
+            const size_type u = path.back();
+
+            if (_M_cur[u] == _M_start[u + 1])
+            {
+                _M_dist[u] = unreachable;
+                path.pop_back();
+
+                if (not path.empty())
+                {
+                    ++_M_cur[path.back()];
+                }
+
+                continue;
+            }
+
+            const size_type v = _M_adj[_M_cur[u]];
+            const size_type w = _M_match_right[v];
+
+            if (w == npos)
+            {
+                if (_M_dist[u] == _M_limit)
+                {
+                    for (const size_type x : path)
+                    {
+                        const size_type y = _M_adj[_M_cur[x]];
+
+                        _M_match_left[x] = y;
+                        _M_match_right[y] = x;
+                    }
+
+                    ++_M_size;
+                    return;
+                }
+
+                ++_M_cur[u];
+            }
+            else if (_M_dist[w] == _M_dist[u] + 1 and _M_dist[w] <= _M_limit)
+            {
+                path.push_back(w);
+            }
+            else
+            {
+                ++_M_cur[u];
+            }
+        }
+    }
+
+    vertex_set
+    _M_konig(bool __independent)
+    {
+        _M_bfs();
+
+        // _M_limit is unreachable here, so the BFS above marked every left vertex of Z.
+        std::vector<bool> right_in_z(right_size());
+
+        for (size_type u = 0; u < left_size(); ++u)
+        {
+            if (_M_dist[u] != unreachable)
+            {
+                for (const size_type v : neighbors(u))
+                {
+                    right_in_z[v] = true;
+                }
+            }
+        }
+
+        vertex_set res;
+
+        for (size_type u = 0; u < left_size(); ++u)
+        {
+            if ((_M_dist[u] != unreachable) == __independent)
+            {
+                res.left.push_back(u);
+            }
+        }
+
+        for (size_type v = 0; v < right_size(); ++v)
+        {
+            if (right_in_z[v] != __independent)
+            {
+                res.right.push_back(v);
+            }
+        }
+
+        return res;
+    }
+
+    // CSR: neighbors of u are _M_adj[_M_start[u], _M_start[u + 1])
+    std::vector<size_type> _M_adj;
+    std::vector<size_type> _M_start;
+
+    std::vector<size_type> _M_deg;
+    std::vector<std::pair<size_type, size_type>> _M_pending;
+
+    std::vector<size_type> _M_match_left;
+    std::vector<size_type> _M_match_right;
+
+    std::vector<size_type> _M_dist;
+    std::vector<size_type> _M_cur;
+    std::vector<size_type> _M_que;
+    std::vector<size_type> _M_path;
+
+    size_type _M_limit = 0;
+    size_type _M_size = 0;
+};
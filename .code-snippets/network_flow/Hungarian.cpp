@@ -0,0 +1,212 @@
+/**
+ * @brief Kuhn-Munkres (Hungarian) assignment on a dense row-major cost matrix, O(min(r, c)^2 max(r, c)).
+ *
+ * Rectangular inputs are fine: every row is assigned if rows <= columns, otherwise every column is.
+ */
+template<typename _CostT = long long>
+requires
+    requires(_CostT __cost) { { -__cost } -> std::convertible_to<_CostT>; } and
+    (not std::unsigned_integral<_CostT>)
+class Hungarian
+{
+public:
+
+    using size_type = int;
+    using cost_type = _CostT;
+
+    static constexpr size_type npos = -1;
+
+    Hungarian(size_type __rows, size_type __cols)
+        : _M_rows(__rows), _M_cols(__cols), _M_cost(std::size_t(__rows) * __cols),
+          _M_row_match(__rows, npos), _M_col_match(__cols, npos)
+    { }
+
+    /**
+     * @param __cost row-major, @p __rows x @p __cols
+     */
+    Hungarian(size_type __rows, size_type __cols, std::vector<cost_type> __cost)
+        : _M_rows(__rows), _M_cols(__cols), _M_cost(std::move(__cost)),
+          _M_row_match(__rows, npos), _M_col_match(__cols, npos)
+    { assert(_M_cost.size() == std::size_t(__rows) * __cols); }
+
+    [[nodiscard]] cost_type&
+    cost(size_type __i, size_type __j)
+    { return _M_cost[std::size_t(__i) * _M_cols + __j]; }
+
+    [[nodiscard]] const cost_type&
+    cost(size_type __i, size_type __j) const
+    { return _M_cost[std::size_t(__i) * _M_cols + __j]; }
+
+    [[nodiscard]] size_type
+    rows() const noexcept
+    { return _M_rows; }
+
+    [[nodiscard]] size_type
+    cols() const noexcept
+    { return _M_cols; }
+
+    /**
+     * @param __comp std::ranges::less for min cost, std::ranges::greater for max cost
+     * @returns total cost of the optimal assignment of min(rows, cols) pairs
+     */
+    template<typename _Comp = std::ranges::less>
+    cost_type
+    solve(_Comp __comp = {})
+    {
+        // Costs are negated for max cost, so the search below always minimises.
+        const bool negate = __comp(cost_type{1}, cost_type{});
+
+        std::ranges::fill(_M_row_match, npos);
+        std::ranges::fill(_M_col_match, npos);
+
+        if (_M_rows == 0 or _M_cols == 0)
+        {
+            return cost_type{};
+        }
+
+        if (_M_rows <= _M_cols)
+        {
+            _M_solve(_M_cost, _M_rows, _M_cols, negate, _M_row_match, _M_col_match);
+        }
+        else
+        {
+            // The row loop needs rows <= columns, so work on the transpose.
+            std::vector<cost_type> t(_M_cost.size());
+
+            for (size_type i = 0; i < _M_rows; ++i)
+            {
+                for (size_type j = 0; j < _M_cols; ++j)
+                {
+                    t[std::size_t(j) * _M_rows + i] = cost(i, j);
+                }
+            }
+
+            _M_solve(t, _M_cols, _M_rows, negate, _M_col_match, _M_row_match);
+        }
+
+        cost_type total{};
+
+        for (size_type i = 0; i < _M_rows; ++i)
+        {
+            if (_M_row_match[i] != npos)
+            {
+                total += cost(i, _M_row_match[i]);
+            }
+        }
+
+        return total;
+    }
+
+    /**
+     * @returns column assigned to row @p __i, or npos
+     */
+    [[nodiscard]] size_type
+    row_match(size_type __i) const
+    { return _M_row_match[__i]; }
+
+    /**
+     * @returns row assigned to column @p __j, or npos
+     */
+    [[nodiscard]] size_type
+    col_match(size_type __j) const
+    { return _M_col_match[__j]; }
+
+private:
+
+    /**
+     * @brief Adds rows one at a time, growing a shortest alternating path tree over the columns with
+     * Dijkstra-like label updates; column 0 of the 1-based arrays is the virtual root.
+     */
+    void
+    _M_solve(const std::vector<cost_type>& __a, size_type __n, size_type __m, bool __negate,
+             std::vector<size_type>& __row_match, std::vector<size_type>& __col_match)
+    {
+        constexpr cost_type inf = std::numeric_limits<cost_type>::max();
+
+        std::vector<cost_type> u(__n + 1), v(__m + 1), minv(__m + 1);
+        std::vector<size_type> p(__m + 1), way(__m + 1);
+        std::vector<bool> used(__m + 1);
+
+        for (size_type i = 1; i <= __n; ++i)
+        {
+            p[0] = i;
+            size_type j0 = 0;
+
+            minv.assign(__m + 1, inf);
+            used.assign(__m + 1, false);
+
+            do
+            {
+                used[j0] = true;
+
+                const size_type i0 = p[j0];
+                const cost_type* row = __a.data() + std::size_t(i0 - 1) * __m;
+
+                cost_type delta = inf;
+                size_type j1 = 0;
+
+                for (size_type j = 1; j <= __m; ++j)
+                {
+                    if (used[j])
+                    {
+                        continue;
+                    }
+
+                    if (const cost_type cur = (__negate ? -row[j - 1] : row[j - 1]) - u[i0] - v[j]; cur < minv[j])
+                    {
+                        minv[j] = cur;
+                        way[j] = j0;
+                    }
+
+                    if (minv[j] < delta)
+                    {
+                        delta = minv[j];
+                        j1 = j;
+                    }
+                }
+
+                for (size_type j = 0; j <= __m; ++j)
+                {
+                    if (used[j])
+                    {
+                        u[p[j]] += delta;
+                        v[j] -= delta;
+                    }
+                    else
+                    {
+                        minv[j] -= delta;
+                    }
+                }
+
+                j0 = j1;
+            }
+            while (p[j0] != 0);
+
+            // Flip the alternating path back to the root.
+            do
+            {
+                const size_type j1 = way[j0];
+                p[j0] = p[j1];
+                j0 = j1;
+            }
+            while (j0 != 0);
+        }
+
+        for (size_type j = 1; j <= __m; ++j)
+        {
+            if (p[j] != 0)
+            {
+                __row_match[p[j] - 1] = j - 1;
+                __col_match[j - 1] = p[j] - 1;
+            }
+        }
+    }
+
+    size_type _M_rows;
+    size_type _M_cols;
+
+    std::vector<cost_type> _M_cost;
+
+    std::vector<size_type> _M_row_match;
+    std::vector<size_type> _M_col_match;
+};
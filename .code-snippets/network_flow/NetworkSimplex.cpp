@@ -0,0 +1,655 @@
+/**
+ * @brief Primal network simplex with block pivoting, for min-cost b-flows with lower bounds.
+ *
+ * The spanning tree is kept as parent / predecessor arc / subtree size per node plus a thread
+ * (preorder successor list), so each pivot only touches the cycle and the re-hung subtree.
+ * Negative costs and negative cycles of finite capacity are fine.
+ */
+template<typename _CapacityT = int, typename _CostT = long long>
+requires
+    std::signed_integral<_CapacityT> and std::signed_integral<_CostT>
+class NetworkSimplex
+{
+public:
+
+    using size_type = int;
+    using capacity_type = _CapacityT;
+    using cost_type = _CostT;
+
+    struct edge
+    {
+        size_type from;
+        size_type to;
+
+        capacity_type lower;
+        capacity_type upper;
+        cost_type cost;
+
+        capacity_type flow;
+    };
+
+    struct cost_flow
+    {
+        cost_type     cost;
+        capacity_type flow;
+    };
+
+    static constexpr capacity_type inf = std::numeric_limits<capacity_type>::max();
+
+    explicit
+    NetworkSimplex(size_type __n = 0) : _M_n(__n), _M_supply(__n)
+    { }
+
+    /**
+     * @returns id of the edge, for edges()[id].flow after solving
+     */
+    size_type
+    add_edge(size_type __from, size_type __to, capacity_type __cap, cost_type __cost)
+    { return add_edge(__from, __to, capacity_type{}, __cap, __cost); }
+
+    size_type
+    add_edge(size_type __from, size_type __to, capacity_type __lower, capacity_type __upper, cost_type __cost)
+    {
+        _M_edges.push_back(edge{__from, __to, __lower, __upper, __cost, capacity_type{}});
+        return size_type(_M_edges.size()) - 1;
+    }
+
+    /**
+     * @param __amount positive for supply, negative for demand
+     */
+    void
+    add_supply(size_type __v, capacity_type __amount)
+    { _M_supply[__v] += __amount; }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return _M_n; }
+
+    [[nodiscard]] std::span<const edge>
+    edges() const noexcept
+    { return _M_edges; }
+
+    [[nodiscard]] capacity_type
+    current_flow() const noexcept
+    { return _M_flow; }
+
+    [[nodiscard]] cost_type
+    current_cost() const noexcept
+    { return _M_cost; }
+
+    /**
+     * @returns whether the last solve found a flow meeting all bounds and supplies
+     */
+    [[nodiscard]] bool
+    feasible() const noexcept
+    { return _M_feasible; }
+
+    /**
+     * @returns dual of @p __v from the last solve (reduced cost = cost + potential(from) - potential(to))
+     */
+    [[nodiscard]] cost_type
+    potential(size_type __v) const
+    { return _M_pi[__v]; }
+
+    /**
+     * @brief Min (or max with std::ranges::greater) cost flow meeting all supplies and bounds.
+     */
+    template<typename _Comp = std::ranges::less>
+    bool
+    solve(_Comp __comp = {})
+    {
+        _M_flow = capacity_type{};
+        return _M_solve(_S_sign(__comp), -1, -1, std::nullopt);
+    }
+
+    cost_flow
+    min_cost_feasible_flow(size_type __source, size_type __sink)
+    { return _M_st_flow(__source, __sink, false, 1); }
+
+    cost_flow
+    max_cost_feasible_flow(size_type __source, size_type __sink)
+    { return _M_st_flow(__source, __sink, false, -1); }
+
+    cost_flow
+    min_cost_max_flow(size_type __source, size_type __sink)
+    { return _M_st_flow(__source, __sink, true, 1); }
+
+    cost_flow
+    max_cost_max_flow(size_type __source, size_type __sink)
+    { return _M_st_flow(__source, __sink, true, -1); }
+
+    void
+    reset()
+    {
+        _M_edges.clear();
+        std::ranges::fill(_M_supply, capacity_type{});
+
+        _M_flow = capacity_type{};
+        _M_cost = cost_type{};
+    }
+
+private:
+
+    enum : signed char
+    {
+        state_upper = -1,
+        state_tree  =  0,
+        state_lower =  1
+    };
+
+    template<typename _Comp>
+    [[nodiscard]] static cost_type
+    _S_sign(_Comp __comp) noexcept
+    { return __comp(cost_type{1}, cost_type{}) ? -1 : 1; }
+
+    /**
+     * @brief Flow from @p __source to @p __sink on top of the supplies, via an extra sink -> source arc.
+     *
+     * For max flow, a first pass with only the return arc priced finds the flow value,
+     * then the second pass fixes it and minimises the real cost.
+     */
+    cost_flow
+    _M_st_flow(size_type __source, size_type __sink, bool __max_flow, cost_type __sign)
+    {
+        if (__max_flow)
+        {
+            if (not _M_solve(0, __source, __sink, std::nullopt))
+            {
+                return cost_flow{.cost = _M_cost = cost_type{}, .flow = _M_flow = capacity_type{}};
+            }
+
+            _M_solve(__sign, __source, __sink, _M_flow);
+        }
+        else
+        {
+            _M_solve(__sign, __source, __sink, std::nullopt);
+        }
+
+        return cost_flow{.cost = _M_cost, .flow = _M_flow};
+    }
+
+    /**
+     * @param __sign 1 for min cost, -1 for max cost, 0 for "maximise the return arc flow only"
+     * @param __fixed if set, the return arc carries exactly this much
+     */
+    bool
+    _M_solve(cost_type __sign, size_type __source, size_type __sink, std::optional<capacity_type> __fixed)
+    {
+        const size_type n = _M_n;
+        const size_type m = size_type(_M_edges.size());
+        const bool with_return = __source != -1 and not __fixed;
+
+        std::vector<capacity_type> supply = _M_supply;
+
+        if (__fixed)
+        {
+            supply[__source] += *__fixed;
+            supply[__sink] -= *__fixed;
+        }
+
+        const size_type arcs = m + with_return;
+
+        _M_from.resize(arcs + n);
+        _M_to.resize(arcs + n);
+        _M_cap.resize(arcs + n);
+        _M_cst.resize(arcs + n);
+        _M_fl.assign(arcs + n, capacity_type{});
+        _M_state.resize(arcs + n);
+
+        cost_type max_cost{};
+
+        for (size_type e = 0; e < m; ++e)
+        {
+            const edge& i = _M_edges[e];
+
+            _M_from[e] = i.from;
+            _M_to[e] = i.to;
+            _M_cap[e] = i.upper - i.lower;
+            _M_cst[e] = i.cost * __sign;
+            _M_state[e] = state_lower;
+
+            supply[i.from] -= i.lower;
+            supply[i.to] += i.lower;
+
+            max_cost = std::max(max_cost, _M_cst[e] < 0 ? -_M_cst[e] : _M_cst[e]);
+        }
+
+        if (with_return)
+        {
+            _M_from[m] = __sink;
+            _M_to[m] = __source;
+            _M_cap[m] = inf;
+            _M_cst[m] = __sign ? cost_type{} : cost_type{-1};
+            _M_state[m] = state_lower;
+
+            max_cost = std::max(max_cost, cost_type{1});
+        }
+
+        if (std::reduce(supply.begin(), supply.end(), capacity_type{}) != capacity_type{})
+        {
+            return _M_feasible = false;
+        }
+
+        _M_init_tree(arcs, supply, (max_cost + 1) * (n + 1));
+
+        const size_type total = arcs + n;
+        const size_type block = std::max(size_type(std::sqrt(double(total))), size_type(10));
+
+        bool bounded = true;
+
+        for (size_type next = 0, in; (in = _M_find_entering(next, block)) != -1; )
+        {
+            if (not _M_pivot(in))
+            {
+                bounded = false;
+                break;
+            }
+        }
+
+        _M_feasible = bounded and std::ranges::all_of(
+            std::views::iota(arcs, total), [&](size_type e) -> bool { return _M_fl[e] == capacity_type{}; });
+
+        _M_cost = cost_type{};
+
+        for (size_type e = 0; e < m; ++e)
+        {
+            edge& i = _M_edges[e];
+
+            i.flow = _M_fl[e] + i.lower;
+            _M_cost += cost_type(i.flow) * i.cost;
+        }
+
+        _M_flow = with_return ? _M_fl[m] : __fixed.value_or(capacity_type{});
+
+        return _M_feasible;
+    }
+
+    void
+    _M_init_tree(size_type __arcs, const std::vector<capacity_type>& __supply, cost_type __art_cost)
+    {
+        const size_type n = _M_n;
+        const size_type root = n;
+
+        _M_parent.assign(n + 1, -1);
+        _M_pred.assign(n + 1, -1);
+        _M_size.assign(n + 1, 1);
+        _M_pi.assign(n + 1, cost_type{});
+
+        _M_thread.resize(n + 1);
+        _M_rev_thread.resize(n + 1);
+        _M_last_succ.resize(n + 1);
+
+        // Artificial arcs between every node and the root carry the initial supplies.
+        for (size_type v = 0; v < n; ++v)
+        {
+            const size_type e = __arcs + v;
+
+            if (__supply[v] >= 0)
+            {
+                _M_from[e] = v;
+                _M_to[e] = root;
+                _M_fl[e] = __supply[v];
+                _M_pi[v] = -__art_cost;
+            }
+            else
+            {
+                _M_from[e] = root;
+                _M_to[e] = v;
+                _M_fl[e] = -__supply[v];
+                _M_pi[v] = __art_cost;
+            }
+
+            _M_cap[e] = inf;
+            _M_cst[e] = __art_cost;
+            _M_state[e] = state_tree;
+
+            _M_parent[v] = root;
+            _M_pred[v] = e;
+
+            _M_thread[v] = v + 1;
+            _M_rev_thread[v + 1] = v;
+            _M_last_succ[v] = v;
+        }
+
+        _M_size[root] = n + 1;
+
+        _M_thread[root] = n ? 0 : root;
+        _M_rev_thread[n ? 0 : root] = root;
+        _M_last_succ[root] = n ? n - 1 : root;
+    }
+
+    [[nodiscard]] cost_type
+    _M_reduced_cost(size_type __e) const noexcept
+    { return _M_cst[__e] + _M_pi[_M_from[__e]] - _M_pi[_M_to[__e]]; }
+
+    /**
+     * @brief Block search: scans @p __block arcs at a time and takes the most violating one seen.
+     */
+    [[nodiscard]] size_type
+    _M_find_entering(size_type& __next, size_type __block) const
+    {
+        const size_type total = size_type(_M_state.size());
+
+        cost_type best{};
+        size_type in = -1;
+
+        for (size_type k = 0, cnt = __block; k < total; ++k)
+        {
+            const size_type e = __next;
+            __next = __next + 1 == total ? 0 : __next + 1;
+
+            if (const cost_type c = _M_state[e] * _M_reduced_cost(e); c < best)
+            {
+                best = c;
+                in = e;
+            }
+
+            if (--cnt == 0)
+            {
+                if (in != -1)
+                {
+                    break;
+                }
+
+                cnt = __block;
+            }
+        }
+
+        return in;
+    }
+
+    [[nodiscard]] capacity_type
+    _M_residual_up(size_type __v) const noexcept
+    {
+        // Residual of pushing along pred[v] from v towards its parent.
+        const size_type e = _M_pred[__v];
+        return _M_from[e] == __v ? (_M_cap[e] == inf ? inf : _M_cap[e] - _M_fl[e]) : _M_fl[e];
+    }
+
+    [[nodiscard]] capacity_type
+    _M_residual_down(size_type __v) const noexcept
+    {
+        // Residual of pushing along pred[v] from the parent down to v.
+        const size_type e = _M_pred[__v];
+        return _M_from[e] == __v ? _M_fl[e] : (_M_cap[e] == inf ? inf : _M_cap[e] - _M_fl[e]);
+    }
+
+    /**
+     * @returns false if the cycle has unbounded capacity
+     */
+    bool
+    _M_pivot(size_type __in)
+    {
+        // Flow goes first -> second on the entering arc, then back through the tree.
+        size_type first = _M_from[__in], second = _M_to[__in];
+
+        if (_M_state[__in] == state_upper)
+        {
+            std::swap(first, second);
+        }
+
+        size_type join = first;
+
+        for (size_type v = second; join != v; )
+        {
+            if (_M_size[join] > _M_size[v])
+            {
+                v = _M_parent[v];
+            }
+            else
+            {
+                join = _M_parent[join];
+            }
+        }
+
+        capacity_type delta = _M_cap[__in];
+        size_type out = -1;
+        int side = 0;
+
+        // '<' on the first side and '<=' on the second keeps the tree strongly feasible.
+        for (size_type v = first; v != join; v = _M_parent[v])
+        {
+            if (const capacity_type d = _M_residual_down(v); d < delta)
+            {
+                delta = d;
+                out = v;
+                side = 1;
+            }
+        }
+
+        for (size_type v = second; v != join; v = _M_parent[v])
+        {
+            if (const capacity_type d = _M_residual_up(v); d <= delta)
+            {
+                delta = d;
+                out = v;
+                side = 2;
+            }
+        }
+
+        if (delta == inf)
+        {
+            return false;
+        }
+
+        if (delta)
+        {
+            _M_fl[__in] += _M_state[__in] * delta;
+
+            for (size_type v = first; v != join; v = _M_parent[v])
+            {
+                const size_type e = _M_pred[v];
+                _M_fl[e] += _M_from[e] == v ? -delta : delta;
+            }
+
+            for (size_type v = second; v != join; v = _M_parent[v])
+            {
+                const size_type e = _M_pred[v];
+                _M_fl[e] += _M_from[e] == v ? delta : -delta;
+            }
+        }
+
+        if (side == 0)
+        {
+            _M_state[__in] = -_M_state[__in];
+            return true;
+        }
+
+        const size_type leaving = _M_pred[out];
+
+        _M_state[leaving] = _M_fl[leaving] == capacity_type{} ? state_lower : state_upper;
+        _M_state[__in] = state_tree;
+
+        const size_type u_in = side == 1 ? first : second;
+        const size_type v_in = side == 1 ? second : first;
+
+        _M_update_tree(__in, join, u_in, v_in, out);
+
+        const cost_type shift = (_M_from[__in] == u_in
+            ? _M_pi[v_in] - _M_cst[__in]
+            : _M_pi[v_in] + _M_cst[__in]) - _M_pi[u_in];
+
+        // Potentials are only defined up to a constant, so shift whichever side of the cut is smaller.
+        const size_type end = _M_thread[_M_last_succ[u_in]];
+
+        if (_M_size[u_in] * 2 <= _M_n + 1)
+        {
+            for (size_type x = u_in; x != end; x = _M_thread[x])
+            {
+                _M_pi[x] += shift;
+            }
+        }
+        else
+        {
+            for (size_type x = end; x != u_in; x = _M_thread[x])
+            {
+                _M_pi[x] -= shift;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Replaces the tree arc above @p __out by @p __in, re-hanging the subtree at @p __u_in below @p __v_in.
+     */
+    void
+    _M_update_tree(size_type __in, size_type __join, size_type __u_in, size_type __v_in, size_type __out)
+    {
+        const size_type old_rev_thread = _M_rev_thread[__out];
+        const size_type old_size = _M_size[__out];
+        const size_type old_last_succ = _M_last_succ[__out];
+        const size_type v_out = _M_parent[__out];
+
+        if (__u_in == __out)
+        {
+            _M_parent[__u_in] = __v_in;
+            _M_pred[__u_in] = __in;
+
+            // Move the block [u_in, last_succ] right after v_in in the thread.
+            if (_M_thread[__v_in] != __out)
+            {
+                size_type after = _M_thread[old_last_succ];
+                _M_thread[old_rev_thread] = after;
+                _M_rev_thread[after] = old_rev_thread;
+
+                after = _M_thread[__v_in];
+                _M_thread[__v_in] = __out;
+                _M_rev_thread[__out] = __v_in;
+                _M_thread[old_last_succ] = after;
+                _M_rev_thread[after] = old_last_succ;
+            }
+        }
+        else
+        {
+            // If old_rev_thread == v_in, then join == v_out as well.
+            const size_type thread_continue = old_rev_thread == __v_in ? _M_thread[old_last_succ] : _M_thread[__v_in];
+
+            // Walk the stem u_in -> out, splicing each stem node's remaining subtree after the previous one.
+            size_type stem = __u_in;
+            size_type par_stem = __v_in;
+            size_type last = _M_last_succ[__u_in];
+            size_type after = _M_thread[last];
+
+            _M_thread[__v_in] = __u_in;
+
+            std::vector<size_type>& dirty = _M_dirty;
+            dirty.clear();
+            dirty.push_back(__v_in);
+
+            while (stem != __out)
+            {
+                const size_type next_stem = _M_parent[stem];
+
+                _M_thread[last] = next_stem;
+                dirty.push_back(last);
+
+                const size_type before = _M_rev_thread[stem];
+                _M_thread[before] = after;
+                _M_rev_thread[after] = before;
+
+                _M_parent[stem] = par_stem;
+                par_stem = stem;
+                stem = next_stem;
+
+                last = _M_last_succ[stem] == _M_last_succ[par_stem] ? _M_rev_thread[par_stem] : _M_last_succ[stem];
+                after = _M_thread[last];
+            }
+
+            _M_parent[__out] = par_stem;
+            _M_thread[last] = thread_continue;
+            _M_rev_thread[thread_continue] = last;
+            _M_last_succ[__out] = last;
+
+            if (old_rev_thread != __v_in)
+            {
+                _M_thread[old_rev_thread] = after;
+                _M_rev_thread[after] = old_rev_thread;
+            }
+
+            for (const size_type u : dirty)
+            {
+                _M_rev_thread[_M_thread[u]] = u;
+            }
+
+            // Stem nodes from out back to u_in: predecessor arcs shift down by one, sizes are recomputed.
+            size_type size = 0;
+            const size_type stem_last = _M_last_succ[__out];
+
+            for (size_type u = __out, p = _M_parent[u]; u != __u_in; u = p, p = _M_parent[u])
+            {
+                _M_pred[u] = _M_pred[p];
+
+                size += _M_size[u] - _M_size[p];
+                _M_size[u] = size;
+
+                _M_last_succ[p] = stem_last;
+            }
+
+            _M_pred[__u_in] = __in;
+            _M_size[__u_in] = old_size;
+        }
+
+        const size_type up_limit_out = _M_last_succ[__join] == __v_in ? __join : -1;
+        const size_type last_succ_out = _M_last_succ[__out];
+
+        for (size_type u = __v_in; u != -1 and _M_last_succ[u] == __v_in; u = _M_parent[u])
+        {
+            _M_last_succ[u] = last_succ_out;
+        }
+
+        if (__join != old_rev_thread and __v_in != old_rev_thread)
+        {
+            for (size_type u = v_out; u != up_limit_out and _M_last_succ[u] == old_last_succ; u = _M_parent[u])
+            {
+                _M_last_succ[u] = old_rev_thread;
+            }
+        }
+        else if (last_succ_out != old_last_succ)
+        {
+            for (size_type u = v_out; u != up_limit_out and _M_last_succ[u] == old_last_succ; u = _M_parent[u])
+            {
+                _M_last_succ[u] = last_succ_out;
+            }
+        }
+
+        for (size_type u = __v_in; u != __join; u = _M_parent[u])
+        {
+            _M_size[u] += old_size;
+        }
+
+        for (size_type u = v_out; u != __join; u = _M_parent[u])
+        {
+            _M_size[u] -= old_size;
+        }
+    }
+
+    size_type _M_n;
+
+    std::vector<edge> _M_edges;
+    std::vector<capacity_type> _M_supply;
+
+    // arcs: user edges, [return arc], then one artificial arc per node
+    std::vector<size_type> _M_from;
+    std::vector<size_type> _M_to;
+    std::vector<capacity_type> _M_cap;
+    std::vector<cost_type> _M_cst;
+    std::vector<capacity_type> _M_fl;
+    std::vector<signed char> _M_state;
+
+    // spanning tree rooted at the artificial node n
+    std::vector<size_type> _M_parent;
+    std::vector<size_type> _M_pred;
+    std::vector<size_type> _M_size;
+    std::vector<cost_type> _M_pi;
+
+    std::vector<size_type> _M_thread;
+    std::vector<size_type> _M_rev_thread;
+    std::vector<size_type> _M_last_succ;
+    std::vector<size_type> _M_dirty;
+
+    bool _M_feasible = false;
+
+    capacity_type _M_flow{};
+    cost_type _M_cost{};
+};
\ No newline at end of file
@@ -0,0 +1,488 @@
+/**
+ * @brief Min-cost flow by successive shortest paths: Dijkstra on reduced costs with Johnson potentials.
+ *
+ * Negative edge costs are handled by one Bellman-Ford (SPFA) pass that initialises the potentials.
+ * Same interface as SpfaDinic.
+ */
+template<typename _CapacityT = int, typename _CostT = int>
+requires
+    requires(_CostT __cost) { { -__cost } -> std::convertible_to<_CostT>; } and
+    (not std::unsigned_integral<_CostT>)
+class PrimalDual
+{
+public:
+
+    using size_type = int;
+    using capacity_type = _CapacityT;
+    using cost_type = _CostT;
+
+    /**
+     * @c rid is the index of the reverse edge in edges(to), with @c rid_mask set on forward edges.
+     */
+    struct edge
+    {
+        size_type to;
+        size_type rid;
+
+        capacity_type cap;
+        cost_type cost;
+    };
+
+    static constexpr size_type rid_mask = size_type{1} << sizeof(size_type) * 8 - 1;
+
+    static constexpr cost_type inf = std::numeric_limits<cost_type>::max();
+
+    explicit
+    PrimalDual(size_type __n = 0) : _M_start(__n + 1), _M_deg(__n)
+    { }
+
+    /**
+     * @returns id for increase_capacity() / decrease_capacity()
+     */
+    size_type
+    add_edge(size_type __from, size_type __to, capacity_type __cap, cost_type __cost)
+    {
+        const size_type fid = _M_deg[__from]++;
+        const size_type tid = _M_deg[__to]++;
+
+        _M_pending.emplace_back(__from, fid, edge{__to, tid | rid_mask, __cap, __cost});
+        _M_pending.emplace_back(__to, tid, edge{__from, fid, capacity_type{}, -__cost});
+
+        _M_ids.emplace_back(__from, fid);
+        return size_type(_M_ids.size()) - 1;
+    }
+
+    /**
+     * @brief Raises the capacity of edge @p __id, the next flow call picks up the extra flow.
+     *
+     * @note Meant for use after restore(): opening a saturated edge of a min-cost residual graph can close a
+     * negative cycle.
+     */
+    void
+    increase_capacity(size_type __id, capacity_type __delta)
+    { _M_forward(__id).cap += __delta; }
+
+    /**
+     * @brief Lowers the residual capacity of edge @p __id by @p __delta, which must not exceed it (after restore(),
+     * the capacity itself). Unlike Dinic::decrease_capacity(), flow through the edge is never cancelled.
+     */
+    void
+    decrease_capacity(size_type __id, capacity_type __delta)
+    { _M_forward(__id).cap -= __delta; }
+
+    /**
+     * @returns residual capacity of edge @p __id
+     */
+    [[nodiscard]] capacity_type
+    residual_capacity(size_type __id)
+    { return _M_forward(__id).cap; }
+
+    /**
+     * @brief Packs all edges added so far into one contiguous array.
+     *
+     * Called by the flow functions automatically; edges added later are merged in by the next call.
+     */
+    void
+    finalize()
+    {
+        if (_M_pending.empty())
+        {
+            return;
+        }
+
+        std::vector<size_type> start(size() + 1);
+
+        for (size_type i = 0; i < size(); ++i)
+        {
+            start[i + 1] = start[i] + _M_deg[i];
+        }
+
+        std::vector<edge> e(start.back());
+
+        for (size_type i = 0; i < size(); ++i)
+        {
+            std::ranges::copy(edges(i), e.begin() + start[i]);
+        }
+
+        for (const auto& [from, id, i] : _M_pending)
+        {
+            e[start[from] + id] = i;
+        }
+
+        _M_e = std::move(e);
+        _M_start = std::move(start);
+
+        _M_pending.clear();
+        _M_pending.shrink_to_fit();
+    }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return size_type(_M_deg.size()); }
+
+    /**
+     * @note Edges added after the last finalize() or flow call are not visible yet.
+     */
+    [[nodiscard]] std::span<const edge>
+    edges(size_type __i) const
+    { return {_M_e.begin() + _M_start[__i], _M_e.begin() + _M_start[__i + 1]}; }
+
+    [[nodiscard]] capacity_type
+    current_flow() const noexcept
+    { return _M_flow; }
+
+    [[nodiscard]] cost_type
+    current_cost() const noexcept
+    { return _M_cost; }
+
+    struct cost_flow
+    {
+        cost_type     cost;
+        capacity_type flow;
+    };
+
+    /**
+     * @param __comp std::ranges::less for min cost, std::ranges::greater for max cost
+     * @param __feasible_only stop as soon as one more unit of flow no longer improves the cost
+     */
+    template<typename _Comp = std::ranges::less>
+    cost_flow
+    solve(size_type __source, size_type __sink, bool __feasible_only, _Comp __comp = {})
+    {
+        finalize();
+
+        // Costs are negated for max cost, so the search below always minimises.
+        const bool negate = __comp(cost_type{1}, cost_type{});
+
+        if (__source == __sink)
+        {
+            return cost_flow{.cost = _M_cost, .flow = _M_flow};
+        }
+
+        _M_init_potential(__source, negate);
+
+        while (_M_dijkstra(__source, __sink, negate))
+        {
+            if (__feasible_only and not (_M_h[__sink] - _M_h[__source] < cost_type{}))
+            {
+                break;
+            }
+
+            _M_flow += _M_augment_flow(__source, __sink, negate);
+        }
+
+        return cost_flow{.cost = _M_cost, .flow = _M_flow};
+    }
+
+    cost_flow
+    min_cost_feasible_flow(size_type __source, size_type __sink)
+    { return solve(__source, __sink, true, std::ranges::less{}); }
+
+    cost_flow
+    max_cost_feasible_flow(size_type __source, size_type __sink)
+    { return solve(__source, __sink, true, std::ranges::greater{}); }
+
+    cost_flow
+    min_cost_max_flow(size_type __source, size_type __sink)
+    { return solve(__source, __sink, false, std::ranges::less{}); }
+
+    cost_flow
+    max_cost_max_flow(size_type __source, size_type __sink)
+    { return solve(__source, __sink, false, std::ranges::greater{}); }
+
+    void
+    restore()
+    {
+        finalize();
+
+        for (edge& i : _M_e)
+        {
+            if (i.rid & rid_mask)
+            {
+                edge& r = _M_reverse(i);
+
+                i.cap += r.cap;
+                r.cap = 0;
+            }
+        }
+
+        _M_flow = capacity_type{};
+        _M_cost = cost_type{};
+    }
+
+    void
+    resize(size_type __n)
+    {
+        finalize();
+
+        _M_start.resize(__n + 1, _M_start.back());
+        _M_deg.resize(__n);
+    }
+
+    void
+    reset()
+    {
+        _M_e.clear();
+        _M_pending.clear();
+        _M_ids.clear();
+
+        std::ranges::fill(_M_start, size_type{});
+        std::ranges::fill(_M_deg, size_type{});
+
+        _M_flow = capacity_type{};
+        _M_cost = cost_type{};
+    }
+
+private:
+
+    [[nodiscard]] edge&
+    _M_reverse(const edge& __i)
+    { return _M_e[_M_start[__i.to] + (__i.rid & ~rid_mask)]; }
+
+    [[nodiscard]] edge&
+    _M_forward(size_type __id)
+    {
+        finalize();
+
+        const auto [from, fid] = _M_ids[__id];
+        return _M_e[_M_start[from] + fid];
+    }
+
+    [[nodiscard]] static cost_type
+    _S_cost(const edge& __i, bool __negate) noexcept
+    { return __negate ? -__i.cost : __i.cost; }
+
+    void
+    _M_init_potential(size_type __source, bool __negate)
+    {
+        const size_type n = size();
+
+        _M_h.assign(n, cost_type{});
+
+        if (std::ranges::none_of(_M_e, [&](const edge& i) -> bool { return i.cap and _S_cost(i, __negate) < cost_type{}; }))
+        {
+            return;
+        }
+
+        // Bellman-Ford (SPFA) over the residual graph.
+        std::vector<cost_type>& dist = _M_dist;
+        dist.assign(n, inf);
+
+        std::vector<char> inq(n);
+        std::queue<size_type> que;
+
+        dist[__source] = cost_type{};
+        que.push(__source);
+
+        while (not que.empty())
+        {
+            const size_type u = que.front();
+            que.pop();
+
+            inq[u] = false;
+
+            for (size_type j = _M_start[u]; j < _M_start[u + 1]; ++j)
+            {
+                const edge& i = _M_e[j];
+
+                if (i.cap and dist[u] + _S_cost(i, __negate) < dist[i.to])
+                {
+                    dist[i.to] = dist[u] + _S_cost(i, __negate);
+
+                    if (not inq[i.to])
+                    {
+                        inq[i.to] = true;
+                        que.push(i.to);
+                    }
+                }
+            }
+        }
+
+        // Vertices unreachable now stay unreachable, any potential works for them.
+        for (size_type u = 0; u < n; ++u)
+        {
+            _M_h[u] = dist[u] == inf ? cost_type{} : dist[u];
+        }
+    }
+
+    /**
+     * @brief Shortest distances on reduced costs, then shifts the potentials by them.
+     *
+     * Stops once the sink is settled; every other vertex is shifted by min(dist, dist[sink]),
+     * which keeps all reduced costs non-negative.
+     *
+     * @returns whether the sink is reachable
+     */
+    bool
+    _M_dijkstra(size_type __source, size_type __sink, bool __negate)
+    {
+        const size_type n = size();
+
+        _M_dist.assign(n, inf);
+
+        using item = std::pair<cost_type, size_type>;
+        std::vector<item>& heap = _M_heap;
+        heap.clear();
+
+        _M_dist[__source] = cost_type{};
+        heap.emplace_back(cost_type{}, __source);
+
+        while (not heap.empty())
+        {
+            std::ranges::pop_heap(heap, std::ranges::greater{});
+            const auto [d, u] = heap.back();
+            heap.pop_back();
+
+            if (d != _M_dist[u])
+            {
+                continue;
+            }
+
+            if (u == __sink)
+            {
+                break;
+            }
+
+            for (size_type j = _M_start[u]; j < _M_start[u + 1]; ++j)
+            {
+                const edge& i = _M_e[j];
+
+                if (not i.cap)
+                {
+                    continue;
+                }
+
+                if (const cost_type nd = d + (_S_cost(i, __negate) + _M_h[u] - _M_h[i.to]); nd < _M_dist[i.to])
+                {
+                    _M_dist[i.to] = nd;
+
+                    heap.emplace_back(nd, i.to);
+                    std::ranges::push_heap(heap, std::ranges::greater{});
+                }
+            }
+        }
+
+        if (_M_dist[__sink] == inf)
+        {
+            return false;
+        }
+
+        for (size_type u = 0; u < n; ++u)
+        {
+            _M_h[u] += std::min(_M_dist[u], _M_dist[__sink]);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Blocking flow over the edges of zero reduced cost.
+     */
+    capacity_type
+    _M_augment_flow(size_type __source, size_type __sink, bool __negate)
+    {
+        const size_type n = size();
+
+        _M_cur.assign(_M_start.begin(), _M_start.end() - 1);
+        _M_vis.assign(n, false);
+
+        auto admissible = [&](size_type __u, const edge& __i) -> bool
+        {
+            return __i.cap and not _M_vis[__i.to] and _M_h[__u] + _S_cost(__i, __negate) == _M_h[__i.to];
+        };
+
+        capacity_type total{};
+
+        std::vector<size_type>& path = _M_path;
+        path.clear();
+
+        _M_vis[__source] = true;
+
+        for (size_type u = __source; ; )
+        {
+            if (u == __sink)
+            {
+                capacity_type flow = std::numeric_limits<capacity_type>::max();
+
+                for (const size_type j : path)
+                {
+                    flow = std::min(flow, _M_e[j].cap);
+                }
+
+                size_type first_saturated = size_type(path.size());
+
+                for (size_type k = size_type(path.size()); k--; )
+                {
+                    edge& i = _M_e[path[k]];
+
+                    i.cap -= flow;
+                    _M_reverse(i).cap += flow;
+
+                    _M_cost += flow * i.cost;
+
+                    if (not i.cap)
+                    {
+                        first_saturated = k;
+                    }
+                }
+
+                total += flow;
+
+                for (size_type k = first_saturated; k < size_type(path.size()); ++k)
+                {
+                    _M_vis[_M_e[path[k]].to] = false;
+                }
+
+                u = _M_reverse(_M_e[path[first_saturated]]).to;
+                path.resize(first_saturated);
+
+                continue;
+            }
+
+            for (; _M_cur[u] < _M_start[u + 1] and not admissible(u, _M_e[_M_cur[u]]); ++_M_cur[u]);
+
+            if (_M_cur[u] < _M_start[u + 1])
+            {
+                path.push_back(_M_cur[u]);
+                u = _M_e[_M_cur[u]].to;
+
+                _M_vis[u] = true;
+            }
+            else if (path.empty())
+            {
+                break;
+            }
+            else
+            {
+                // Dead end: leave it marked so it is not entered again in this phase.
+                u = _M_reverse(_M_e[path.back()]).to;
+                path.pop_back();
+
+                ++_M_cur[u];
+            }
+        }
+
+        return total;
+    }
+
+    // CSR: edges of u are _M_e[_M_start[u], _M_start[u + 1])
+    std::vector<edge> _M_e;
+    std::vector<size_type> _M_start;
+
+    std::vector<size_type> _M_deg;
+    std::vector<std::tuple<size_type, size_type, edge>> _M_pending;
+
+    // edge id -> (from, index in edges(from))
+    std::vector<std::pair<size_type, size_type>> _M_ids;
+
+    std::vector<cost_type> _M_h;
+    std::vector<cost_type> _M_dist;
+    std::vector<std::pair<cost_type, size_type>> _M_heap;
+
+    std::vector<size_type> _M_cur;
+    std::vector<size_type> _M_path;
+    std::vector<bool> _M_vis;
+
+    capacity_type _M_flow{};
+    cost_type _M_cost{};
+};
\ No newline at end of file
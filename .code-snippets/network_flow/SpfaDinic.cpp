@@ -25,13 +25,44 @@ public:
     SpfaDinic(size_type __n = 0) : _M_e(__n), _M_cg(__n), _M_vis(__n), _M_cur(__n)
     { }
 
-    void
+    /**
+     * @returns id for increase_capacity() / decrease_capacity()
+     */
+    size_type
     add_edge(size_type __from, size_type __to, capacity_type __cap, cost_type __cost)
     {
         _M_e[__from].emplace_back(__to, size_type(_M_e[__to].size()) | rid_mask, __cap, __cost);
         _M_e[__to].emplace_back(__from, size_type(_M_e[__from].size()) - 1, capacity_type{}, -__cost);
+
+        _M_ids.emplace_back(__from, size_type(_M_e[__from].size()) - 1);
+        return size_type(_M_ids.size()) - 1;
     }
 
+    /**
+     * @brief Raises the capacity of edge @p __id, the next flow call picks up the extra flow.
+     *
+     * @note Meant for use after restore(): opening a saturated edge of a min-cost residual graph can close a
+     * negative cycle.
+     */
+    void
+    increase_capacity(size_type __id, capacity_type __delta)
+    { _M_forward(__id).cap += __delta; }
+
+    /**
+     * @brief Lowers the residual capacity of edge @p __id by @p __delta, which must not exceed it (after restore(),
+     * the capacity itself). Unlike Dinic::decrease_capacity(), flow through the edge is never cancelled.
+     */
+    void
+    decrease_capacity(size_type __id, capacity_type __delta)
+    { _M_forward(__id).cap -= __delta; }
+
+    /**
+     * @returns residual capacity of edge @p __id
+     */
+    [[nodiscard]] capacity_type
+    residual_capacity(size_type __id)
+    { return _M_forward(__id).cap; }
+
     [[nodiscard]] size_type
     size() const noexcept
     { return size_type(_M_e.size()); }
@@ -192,12 +223,21 @@ public:
             i.clear();
         }
 
+        _M_ids.clear();
+
         _M_flow = capacity_type{};
         _M_cost = cost_type{};
     }
 
 private:
 
+    [[nodiscard]] edge&
+    _M_forward(size_type __id)
+    {
+        const auto [from, fid] = _M_ids[__id];
+        return _M_e[from][fid];
+    }
+
     capacity_type
     _M_augment_flow(size_type __u, size_type __sink, capacity_type __limit)
     {
@@ -235,6 +275,10 @@ private:
     }
 
     std::vector<std::vector<edge>> _M_e;
+
+    // edge id -> (from, index in edges(from))
+    std::vector<std::pair<size_type, size_type>> _M_ids;
+
     std::vector<cost_type> _M_cg;
 
     std::vector<bool> _M_vis;
@@ -0,0 +1,768 @@
+/**
+ * @brief Alphabets for AhoCorasick: @c size symbols and @c index mapping a character to [0, size).
+ */
+struct AhoCorasickAlphabet
+{
+    template<int _First = 'a', int _Size = 26>
+    struct Range
+    {
+        static constexpr int size = _Size;
+
+        [[nodiscard]] static constexpr int
+        index(int __c) noexcept
+        { return __c - _First; }
+    };
+
+    using Lower = Range<'a', 26>;
+    using Upper = Range<'A', 26>;
+    using Digit = Range<'0', 10>;
+
+    struct Byte
+    {
+        static constexpr int size = 256;
+
+        [[nodiscard]] static constexpr int
+        index(int __c) noexcept
+        { return static_cast<unsigned char>(__c); }
+    };
+};
+
+/**
+ * @brief Aho-Corasick automaton over any alphabet, with full goto compilation or a lean sparse layout.
+ *
+ * build() renumbers the trie in BFS order, so the children of every node are one contiguous id range sorted by
+ * symbol and the nodes of depth < d are exactly the ids below some bound. Nodes shallower than @c dense_depth get a
+ * compiled goto row of alphabet size; deeper nodes keep only their own edges (one symbol byte each) and follow fail
+ * links on a miss, which is amortized O(1) per character.
+ *
+ * The default compiles every node (one row per node, the classic layout); dense_depth = 1 keeps only the root's row.
+ *
+ * An empty pattern ends at the root and occurs at every position 0, 1, ..., n of a text of length n, like in Kmp;
+ * the position 0 match is reported before the first character.
+ *
+ * @note Patterns are inserted first and build() is called once.
+ */
+template<typename _Alphabet = AhoCorasickAlphabet::Lower>
+class AhoCorasick
+{
+public:
+
+    using size_type = int;
+    using alphabet_type = _Alphabet;
+
+    static constexpr size_type npos = -1;
+    static constexpr size_type sigma = _Alphabet::size;
+
+    /**
+     * @brief Resumable matcher: keeps the automaton state across feed() calls and reports global offsets, so a text
+     * can be scanned chunk by chunk with memory independent of its length.
+     *
+     * @note The automaton must be built and must outlive the stream.
+     */
+    class Stream
+    {
+    public:
+
+        using offset_type = int64;
+
+        explicit
+        Stream(const AhoCorasick& __ac) noexcept
+            : _M_ac(&__ac)
+        { }
+
+        /**
+         * @brief Writes a [global start, pattern id] pair for every occurrence ending inside @p __chunk, in the order
+         * of AhoCorasick::find_all().
+         */
+        template<std::output_iterator<std::pair<offset_type, size_type>> _Out>
+        _Out
+        feed(std::string_view __chunk, _Out __result)
+        {
+            const AhoCorasick& ac = *_M_ac;
+            size_type v = _M_state;
+
+            // Empty patterns at position 0, once per stream.
+            if (not std::exchange(_M_begun, true))
+            {
+                for (size_type w = ac._M_word[0]; w != npos; w = ac._M_same[w])
+                {
+                    *__result = std::pair<offset_type, size_type>(0, w);
+                    ++__result;
+                }
+            }
+
+            for (const char ch : __chunk)
+            {
+                v = ac.next(v, ch);
+                ++_M_offset;
+
+                for (size_type u = ac._M_word[v] != npos ? v : ac._M_out[v]; u != npos; u = ac._M_out[u])
+                {
+                    for (size_type w = ac._M_word[u]; w != npos; w = ac._M_same[w])
+                    {
+                        *__result = std::pair<offset_type, size_type>(_M_offset - ac._M_depth[u], w);
+                        ++__result;
+                    }
+                }
+            }
+
+            _M_state = v;
+            return __result;
+        }
+
+        /**
+         * @returns number of characters fed so far
+         */
+        [[nodiscard]] offset_type
+        offset() const noexcept
+        { return _M_offset; }
+
+        /**
+         * @returns automaton node reached by the input so far
+         */
+        [[nodiscard]] size_type
+        state() const noexcept
+        { return _M_state; }
+
+        void
+        reset() noexcept
+        { _M_offset = 0, _M_state = 0, _M_begun = false; }
+
+    private:
+
+        const AhoCorasick* _M_ac;
+
+        offset_type _M_offset = 0;
+        size_type _M_state = 0;
+
+        bool _M_begun = false;
+    };
+
+    /**
+     * @brief Dynamic dictionary matching: patterns are switched on and off, and count() totals the occurrences of
+     * the active ones.
+     *
+     * Activating a pattern adds 1 over the fail subtree of its node (an interval of fail_tree_order()), so the point
+     * value at a node is the number of active patterns that are suffixes of it, kept in a range-add / point-query
+     * Fenwick tree of size + 1 cells.
+     *
+     * @note The automaton must be built and must outlive the counter.
+     */
+    class ActiveSetCounter
+    {
+    public:
+
+        using count_type = int64;
+
+        /**
+         * @param __active whether the patterns start active
+         */
+        explicit
+        ActiveSetCounter(const AhoCorasick& __ac, bool __active = true)
+            : _M_ac(&__ac), _M_order(__ac.fail_tree_order()), _M_tree(__ac.size() + 1), _M_active(__ac.patterns(), __active)
+        {
+            if (__active)
+            {
+                // Difference array in Euler order, then the O(n) Fenwick build over it.
+                for (size_type i = 0; i < __ac.patterns(); ++i)
+                {
+                    const size_type v = __ac._M_node[i];
+
+                    ++_M_tree[_M_order.first[v] + 1];
+
+                    // A subtree reaching the end of the order needs no closing -1.
+                    if (_M_order.second[v] < __ac.size())
+                    {
+                        --_M_tree[_M_order.second[v] + 1];
+                    }
+                }
+
+                for (size_type i = 1; i < __ac.size(); ++i)
+                {
+                    if (const size_type j = i + (i & -i); j <= __ac.size())
+                    {
+                        _M_tree[j] += _M_tree[i];
+                    }
+                }
+            }
+        }
+
+        /**
+         * @returns whether pattern @p __id was inactive
+         */
+        bool
+        activate(size_type __id)
+        { return _M_toggle(__id, true); }
+
+        /**
+         * @returns whether pattern @p __id was active
+         */
+        bool
+        deactivate(size_type __id)
+        { return _M_toggle(__id, false); }
+
+        [[nodiscard]] bool
+        is_active(size_type __id) const
+        { return _M_active[__id]; }
+
+        /**
+         * @returns number of active patterns ending at the end of node @p __v's string
+         */
+        [[nodiscard]] count_type
+        matches(size_type __v) const
+        {
+            count_type res = 0;
+
+            for (size_type i = _M_order.first[__v] + 1; i > 0; i -= i & -i)
+            {
+                res += _M_tree[i];
+            }
+
+            return res;
+        }
+
+        /**
+         * @returns number of occurrences of active patterns in @p __text, overlapping ones included
+         */
+        template<std::ranges::input_range _Range>
+        [[nodiscard]] count_type
+        count(_Range&& __text) const
+        {
+            // matches(0) counts the active empty patterns at position 0.
+            count_type res = matches(0);
+
+            for (size_type v = 0; const auto& ch : __text)
+            {
+                res += matches(v = _M_ac->next(v, static_cast<int>(ch)));
+            }
+
+            return res;
+        }
+
+    private:
+
+        bool
+        _M_toggle(size_type __id, bool __on)
+        {
+            if (_M_active[__id] == __on)
+            {
+                return false;
+            }
+
+            _M_active[__id] = __on;
+
+            const size_type v = _M_ac->_M_node[__id];
+            const count_type d = __on ? 1 : -1;
+
+            _M_add(_M_order.first[v], d);
+            _M_add(_M_order.second[v], -d);
+
+            return true;
+        }
+
+        void
+        _M_add(size_type __i, count_type __d)
+        {
+            for (++__i; __i < size_type(_M_tree.size()); __i += __i & -__i)
+            {
+                _M_tree[__i] += __d;
+            }
+        }
+
+        const AhoCorasick* _M_ac;
+
+        std::pair<std::vector<size_type>, std::vector<size_type>> _M_order;
+        // 1-based Fenwick tree over the Euler order
+        std::vector<count_type> _M_tree;
+
+        std::vector<bool> _M_active;
+    };
+
+    /**
+     * @brief Scratch buffers of build(). Callers that clear and rebuild an automaton repeatedly keep one and pass it
+     * to build(Workspace&), so the rebuilds reuse its storage instead of allocating.
+     */
+    class Workspace;
+
+    /**
+     * @brief dense_depth of a fully compiled automaton.
+     */
+    static constexpr size_type compiled = std::numeric_limits<size_type>::max();
+
+    /**
+     * @param __dense_depth nodes shallower than this get a compiled goto row, at least the root always does
+     */
+    explicit
+    AhoCorasick(size_type __dense_depth = compiled)
+        : _M_dense_depth(std::max(__dense_depth, 1))
+    { clear(); }
+
+    /**
+     * @brief Inserts every range of @p __patterns and builds.
+     */
+    template<std::ranges::input_range _Patterns>
+    requires std::ranges::input_range<std::ranges::range_reference_t<_Patterns>>
+    explicit
+    AhoCorasick(_Patterns&& __patterns, size_type __dense_depth = compiled)
+        : AhoCorasick(__dense_depth)
+    {
+        for (auto&& p : __patterns)
+        {
+            insert(p);
+        }
+
+        build();
+    }
+
+    /**
+     * @returns id of the pattern, ids are 0, 1, 2, ... in insertion order
+     */
+    template<std::ranges::input_range _Range>
+    size_type
+    insert(_Range&& __r)
+    {
+        size_type v = 0;
+
+        for (const auto& ch : __r)
+        {
+            const auto c = static_cast<symbol_type>(_Alphabet::index(static_cast<int>(ch)));
+
+            size_type u = _M_first[v];
+
+            for (; u != npos and _M_symbol[u] != c; u = _M_sibling[u]);
+
+            if (u == npos)
+            {
+                u = static_cast<size_type>(_M_symbol.size());
+
+                _M_symbol.push_back(c);
+                _M_first.push_back(npos);
+                _M_sibling.push_back(_M_first[v]);
+
+                _M_first[v] = u;
+            }
+
+            v = u;
+        }
+
+        _M_node.push_back(v);
+        return patterns() - 1;
+    }
+
+    /**
+     * @brief Renumbers the trie in BFS order, then computes fail links, output links and goto rows in that order.
+     *
+     * The scratch and the insertion-time sibling lists are released afterwards.
+     */
+    void
+    build()
+    {
+        Workspace ws;
+        build(ws);
+
+        std::vector<size_type>().swap(_M_sibling);
+    }
+
+    /**
+     * @brief build() with the scratch in @p __ws, and the sibling lists kept for reuse by the next clear().
+     */
+    void
+    build(Workspace& __ws)
+    {
+        const size_type n = size();
+
+        // BFS over the insertion trie with a flat queue, new id = position in the queue.
+        std::vector<size_type>& order = __ws._M_order;
+        std::vector<size_type>& parent = __ws._M_parent;
+        std::vector<size_type>& children = __ws._M_children;
+
+        std::vector<size_type>& first = __ws._M_first;
+        std::vector<symbol_type>& symbol = __ws._M_symbol;
+
+        order.assign(1, 0);
+        parent.assign(n, npos);
+        first.resize(n + 1);
+        symbol.resize(n);
+
+        for (size_type qi = 0; qi < size_type(order.size()); ++qi)
+        {
+            const size_type v = order[qi];
+
+            children.clear();
+
+            for (size_type u = _M_first[v]; u != npos; u = _M_sibling[u])
+            {
+                children.push_back(u);
+            }
+
+            std::ranges::sort(children, {}, [this](size_type u) -> symbol_type { return _M_symbol[u]; });
+
+            first[qi] = static_cast<size_type>(order.size());
+
+            for (const size_type u : children)
+            {
+                // parent in new ids
+                parent[order.size()] = qi;
+                order.push_back(u);
+            }
+        }
+
+        first[n] = n;
+
+        // The sibling lists are consumed, their storage maps old ids to new ones.
+        std::vector<size_type>& id = _M_sibling;
+
+        for (size_type x = 0; x < n; ++x)
+        {
+            symbol[x] = _M_symbol[order[x]];
+            id[order[x]] = x;
+        }
+
+        for (size_type& v : _M_node)
+        {
+            v = id[v];
+        }
+
+        // The old arrays become the workspace's buffers for the next build.
+        _M_symbol.swap(symbol);
+        _M_first.swap(first);
+
+        _M_fail.assign(n, 0);
+        _M_depth.assign(n, 0);
+        _M_out.assign(n, npos);
+        _M_word.assign(n, npos);
+        _M_same.assign(patterns(), npos);
+
+        for (size_type i = patterns() - 1; i >= 0; --i)
+        {
+            _M_same[i] = std::exchange(_M_word[_M_node[i]], i);
+        }
+
+        for (size_type x = 1; x < n; ++x)
+        {
+            _M_depth[x] = _M_depth[parent[x]] + 1;
+        }
+
+        _M_dense = static_cast<size_type>(std::ranges::partition_point(_M_depth, [this](size_type d) -> bool { return d < _M_dense_depth; }) - _M_depth.begin());
+        _M_goto.assign(static_cast<std::size_t>(_M_dense) * sigma, 0);
+
+        // Everything a node needs (its fail target, that target's row) has a smaller id.
+        for (size_type x = 0; x < n; ++x)
+        {
+            if (const size_type p = parent[x]; p > 0)
+            {
+                _M_fail[x] = _M_transition(_M_fail[p], _M_symbol[x]);
+            }
+
+            if (x > 0)
+            {
+                const size_type f = _M_fail[x];
+                _M_out[x] = _M_word[f] != npos ? f : _M_out[f];
+            }
+
+            if (x < _M_dense)
+            {
+                size_type* row = _M_goto.data() + static_cast<std::size_t>(x) * sigma;
+
+                for (size_type c = 0; c < sigma; ++c)
+                {
+                    row[c] = x == 0 ? 0 : _M_transition(_M_fail[x], static_cast<symbol_type>(c));
+                }
+
+                for (size_type y = _M_first[x]; y < _M_first[x + 1]; ++y)
+                {
+                    row[_M_symbol[y]] = y;
+                }
+            }
+        }
+    }
+
+    /**
+     * @returns number of nodes, the root included
+     */
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return static_cast<size_type>(_M_symbol.size()); }
+
+    [[nodiscard]] size_type
+    patterns() const noexcept
+    { return static_cast<size_type>(_M_node.size()); }
+
+    [[nodiscard]] bool
+    empty() const noexcept
+    { return patterns() == 0; }
+
+    /**
+     * @returns number of nodes with a compiled goto row
+     */
+    [[nodiscard]] size_type
+    dense_size() const noexcept
+    { return _M_dense; }
+
+    void
+    clear()
+    {
+        _M_symbol.assign(1, symbol_type{});
+        _M_first.assign(1, npos);
+        _M_sibling.assign(1, npos);
+
+        _M_node.clear();
+        _M_fail.clear();
+        _M_depth.clear();
+        _M_out.clear();
+        _M_word.clear();
+        _M_same.clear();
+        _M_goto.clear();
+
+        _M_dense = 0;
+    }
+
+    /**
+     * @returns node reached from @p __v by the character @p __c
+     */
+    [[nodiscard]] size_type
+    next(size_type __v, int __c) const
+    { return _M_transition(__v, static_cast<symbol_type>(_Alphabet::index(__c))); }
+
+    [[nodiscard]] size_type
+    fail(size_type __v) const
+    { return _M_fail[__v]; }
+
+    [[nodiscard]] size_type
+    depth(size_type __v) const
+    { return _M_depth[__v]; }
+
+    /**
+     * @returns node where pattern @p __id ends
+     */
+    [[nodiscard]] size_type
+    node(size_type __id) const
+    { return _M_node[__id]; }
+
+    /**
+     * @returns nearest proper fail ancestor of @p __v where a pattern ends, or npos
+     */
+    [[nodiscard]] size_type
+    output_link(size_type __v) const
+    { return _M_out[__v]; }
+
+    /**
+     * @brief Euler tour of the fail tree (the tree of fail links rooted at 0), computed from subtree sizes in O(n)
+     * since every fail link points to a smaller id.
+     *
+     * @returns [tin, tout], the fail subtree of v is the node set with tin in [tin[v], tout[v]), that is every node
+     * having the string of v as a suffix
+     */
+    [[nodiscard]] std::pair<std::vector<size_type>, std::vector<size_type>>
+    fail_tree_order() const
+    {
+        const size_type n = size();
+
+        std::vector<size_type> tin(n), tout(n, 1);
+
+        for (size_type x = n - 1; x > 0; --x)
+        {
+            tout[_M_fail[x]] += tout[x];
+        }
+
+        // tout holds subtree sizes here, next[v] is the first free slot among v's children.
+        std::vector<size_type> next(n, 1);
+
+        for (size_type x = 1; x < n; ++x)
+        {
+            tin[x] = next[_M_fail[x]];
+            next[_M_fail[x]] += tout[x];
+            next[x] = tin[x] + 1;
+        }
+
+        for (size_type x = 0; x < n; ++x)
+        {
+            tout[x] += tin[x];
+        }
+
+        return {std::move(tin), std::move(tout)};
+    }
+
+    /**
+     * @returns number of occurrences of every pattern in @p __text, overlapping ones included
+     */
+    template<std::ranges::input_range _Range>
+    [[nodiscard]] std::vector<size_type>
+    count(_Range&& __text) const
+    {
+        // The root starts at 1 for the empty prefix, i.e. empty patterns at position 0.
+        std::vector<size_type> hits(size());
+        hits[0] = 1;
+
+        for (size_type v = 0; const auto& ch : __text)
+        {
+            ++hits[v = next(v, static_cast<int>(ch))];
+        }
+
+        // Reverse BFS order visits every node before its fail target.
+        for (size_type x = size() - 1; x > 0; --x)
+        {
+            hits[_M_fail[x]] += hits[x];
+        }
+
+        std::vector<size_type> res(patterns());
+
+        for (size_type i = 0; i < patterns(); ++i)
+        {
+            res[i] = hits[_M_node[i]];
+        }
+
+        return res;
+    }
+
+    /**
+     * @brief Writes a [start, pattern id] pair for every occurrence in @p __text, by end position, longest first.
+     */
+    template<std::ranges::input_range _Range, std::output_iterator<std::pair<size_type, size_type>> _Out>
+    _Out
+    find_all(_Range&& __text, _Out __result) const
+    {
+        for (size_type w = _M_word[0]; w != npos; w = _M_same[w])
+        {
+            *__result = std::pair<size_type, size_type>(0, w);
+            ++__result;
+        }
+
+        size_type v = 0, i = 0;
+
+        for (const auto& ch : __text)
+        {
+            v = next(v, static_cast<int>(ch));
+            ++i;
+
+            for (size_type u = _M_word[v] != npos ? v : _M_out[v]; u != npos; u = _M_out[u])
+            {
+                for (size_type w = _M_word[u]; w != npos; w = _M_same[w])
+                {
+                    *__result = std::pair<size_type, size_type>(i - _M_depth[u], w);
+                    ++__result;
+                }
+            }
+        }
+
+        return __result;
+    }
+
+#if __has_include(<generator>) && defined(__cpp_lib_generator)
+    template<std::ranges::input_range _Range>
+    [[nodiscard]] std::generator<std::pair<size_type, size_type>>
+    find_all(_Range&& __text) const
+    {
+        for (size_type w = _M_word[0]; w != npos; w = _M_same[w])
+        {
+            co_yield std::pair<size_type, size_type>(0, w);
+        }
+
+        size_type v = 0, i = 0;
+
+        for (const auto& ch : __text)
+        {
+            v = next(v, static_cast<int>(ch));
+            ++i;
+
+            for (size_type u = _M_word[v] != npos ? v : _M_out[v]; u != npos; u = _M_out[u])
+            {
+                for (size_type w = _M_word[u]; w != npos; w = _M_same[w])
+                {
+                    co_yield std::pair<size_type, size_type>(i - _M_depth[u], w);
+                }
+            }
+        }
+    }
+#endif
+
+    /**
+     * @returns whether any pattern occurs in @p __text
+     */
+    template<std::ranges::input_range _Range>
+    [[nodiscard]] bool
+    contains(_Range&& __text) const
+    {
+        if (_M_word[0] != npos)
+        {
+            return true;
+        }
+
+        for (size_type v = 0; const auto& ch : __text)
+        {
+            if (v = next(v, static_cast<int>(ch)); _M_word[v] != npos or _M_out[v] != npos)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    [[nodiscard]] Stream
+    stream() const noexcept
+    { return Stream(*this); }
+
+private:
+
+    using symbol_type = std::conditional_t<(_Alphabet::size <= 256), uint8, int>;
+
+public:
+
+    class Workspace
+    {
+    private:
+
+        friend class AhoCorasick;
+
+        // BFS order and parents (new ids), the children being sorted, and the renumbered arrays before the swap
+        std::vector<size_type> _M_order;
+        std::vector<size_type> _M_parent;
+        std::vector<size_type> _M_children;
+        std::vector<size_type> _M_first;
+        std::vector<symbol_type> _M_symbol;
+    };
+
+private:
+
+    [[nodiscard]] size_type
+    _M_transition(size_type __v, symbol_type __c) const
+    {
+        for (; __v >= _M_dense; __v = _M_fail[__v])
+        {
+            for (size_type y = _M_first[__v]; y < _M_first[__v + 1] and _M_symbol[y] <= __c; ++y)
+            {
+                if (_M_symbol[y] == __c)
+                {
+                    return y;
+                }
+            }
+        }
+
+        return _M_goto[static_cast<std::size_t>(__v) * sigma + __c];
+    }
+
+    size_type _M_dense_depth;
+
+    // symbol on the edge into each node
+    std::vector<symbol_type> _M_symbol;
+
+    // before build(): first child and next sibling lists; after: children of x are [_M_first[x], _M_first[x + 1]),
+    // and _M_sibling is released, or only kept as storage by build(Workspace&)
+    std::vector<size_type> _M_first;
+    std::vector<size_type> _M_sibling;
+
+    std::vector<size_type> _M_node;
+
+    std::vector<size_type> _M_fail;
+    std::vector<size_type> _M_depth;
+    std::vector<size_type> _M_out;
+
+    // first pattern ending at each node, then the others through _M_same
+    std::vector<size_type> _M_word;
+    std::vector<size_type> _M_same;
+
+    // goto rows of nodes [0, _M_dense)
+    std::vector<size_type> _M_goto;
+    size_type _M_dense = 0;
+};
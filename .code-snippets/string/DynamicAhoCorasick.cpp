@@ -0,0 +1,215 @@
+/**
+ * @brief Dictionary matching under pattern insertions and deletions, by logarithmic rebuilding of AhoCorasick.
+ *
+ * Inserted patterns live in levels of 1, 2, 4, ... patterns like the bits of a binary counter: an insertion merges
+ * the full levels below the first empty one into it and rebuilds that one automaton, so every pattern is rebuilt
+ * O(log n) times, O(L log n) amortized per update. Deletions insert the pattern into a second, negative instance,
+ * and counts are the difference of the two.
+ *
+ * Cleared levels keep their pattern arena and automaton buffers, and all rebuilds share one AhoCorasick::Workspace,
+ * so later merges into them do not allocate again.
+ *
+ * @note Needs AhoCorasick. erase() must only be given a live pattern (multiset semantics).
+ */
+template<typename _Alphabet = AhoCorasickAlphabet::Lower>
+class DynamicAhoCorasick
+{
+public:
+
+    using size_type = int;
+    using count_type = int64;
+    using automaton_type = AhoCorasick<_Alphabet>;
+
+    /**
+     * @param __dense_depth passed to every automaton, see AhoCorasick
+     */
+    explicit
+    DynamicAhoCorasick(size_type __dense_depth = automaton_type::compiled)
+        : _M_insert(__dense_depth), _M_erase(__dense_depth)
+    { }
+
+    void
+    insert(std::string_view __pattern)
+    { _M_insert.insert(__pattern); }
+
+    void
+    erase(std::string_view __pattern)
+    { _M_erase.insert(__pattern); }
+
+    /**
+     * @returns number of live patterns, duplicates included
+     */
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return _M_insert.size() - _M_erase.size(); }
+
+    [[nodiscard]] bool
+    empty() const noexcept
+    { return size() == 0; }
+
+    /**
+     * @returns total number of occurrences of the live patterns in @p __text, overlapping ones included
+     */
+    template<std::ranges::forward_range _Range>
+    [[nodiscard]] count_type
+    count_occurrences(_Range&& __text) const
+    { return _M_insert.count(__text) - _M_erase.count(__text); }
+
+    void
+    clear()
+    {
+        _M_insert.clear();
+        _M_erase.clear();
+    }
+
+private:
+
+    class _Levels
+    {
+    public:
+
+        explicit
+        _Levels(size_type __dense_depth)
+            : _M_dense_depth(__dense_depth)
+        { }
+
+        void
+        insert(std::string_view __pattern)
+        {
+            size_type t = 0;
+
+            for (; t < size_type(_M_level.size()) and not _M_level[t].end.empty(); ++t);
+
+            if (t == size_type(_M_level.size()))
+            {
+                _M_level.emplace_back(_M_dense_depth);
+            }
+
+            // Levels [0, t) hold 1 + 2 + ... + 2^(t-1) patterns, with the new one exactly 2^t for level t.
+            _Level& dst = _M_level[t];
+
+            for (size_type k = 0; k < t; ++k)
+            {
+                _Level& src = _M_level[k];
+                const size_type base = size_type(dst.text.size());
+
+                dst.text += src.text;
+
+                for (const size_type e : src.end)
+                {
+                    dst.end.push_back(base + e);
+                }
+
+                src.clear();
+            }
+
+            dst.text += __pattern;
+            dst.end.push_back(size_type(dst.text.size()));
+
+            dst.rebuild(_M_workspace);
+            ++_M_size;
+        }
+
+        [[nodiscard]] size_type
+        size() const noexcept
+        { return _M_size; }
+
+        template<typename _Range>
+        [[nodiscard]] count_type
+        count(const _Range& __text) const
+        {
+            count_type res = 0;
+
+            for (const _Level& level : _M_level)
+            {
+                if (level.end.empty())
+                {
+                    continue;
+                }
+
+                // hits[0] is the number of empty patterns, which also occur at position 0.
+                res += level.hits[0];
+
+                for (size_type v = 0; const auto& ch : __text)
+                {
+                    res += level.hits[v = level.ac.next(v, static_cast<int>(ch))];
+                }
+            }
+
+            return res;
+        }
+
+        void
+        clear()
+        {
+            for (_Level& level : _M_level)
+            {
+                level.clear();
+            }
+
+            _M_size = 0;
+        }
+
+    private:
+
+        struct _Level
+        {
+            explicit
+            _Level(size_type __dense_depth)
+                : ac(__dense_depth)
+            { }
+
+            void
+            rebuild(typename automaton_type::Workspace& __ws)
+            {
+                ac.clear();
+
+                for (size_type b = 0; const size_type e : end)
+                {
+                    ac.insert(std::string_view(text).substr(b, e - b));
+                    b = e;
+                }
+
+                ac.build(__ws);
+
+                // hits[v]: patterns ending at the end of v's string, fail[v] < v so one forward pass suffices.
+                hits.assign(ac.size(), 0);
+
+                for (size_type i = 0; i < ac.patterns(); ++i)
+                {
+                    ++hits[ac.node(i)];
+                }
+
+                for (size_type v = 1; v < ac.size(); ++v)
+                {
+                    hits[v] += hits[ac.fail(v)];
+                }
+            }
+
+            void
+            clear()
+            {
+                text.clear();
+                end.clear();
+                hits.clear();
+                ac.clear();
+            }
+
+            // patterns concatenated, the i-th ends at end[i]
+            std::string text;
+            std::vector<size_type> end;
+
+            automaton_type ac;
+            std::vector<count_type> hits;
+        };
+
+        size_type _M_dense_depth;
+        size_type _M_size = 0;
+
+        std::vector<_Level> _M_level;
+        typename automaton_type::Workspace _M_workspace;
+    };
+
+    _Levels _M_insert;
+    _Levels _M_erase;
+};
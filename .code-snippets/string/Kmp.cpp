@@ -1,3 +1,13 @@
+/**
+ * @brief Knuth-Morris-Pratt matcher.
+ *
+ * While no pattern prefix is matched, the scans jump to the next position holding the first two pattern bytes
+ * (AVX2 / SSE2 compares, std::memchr for one-byte patterns) instead of stepping through the prefix-function loop.
+ * No occurrence can start in the skipped bytes, and every byte is still inspected O(1) times, so the worst case
+ * stays linear.
+ *
+ * @note The intrinsics need <immintrin.h> from the contest template prelude.
+ */
 class Kmp
 {
 public:
@@ -7,6 +17,109 @@ public:
 
     static constexpr size_type npos = size_type(-1);
 
+    /**
+     * @brief Resumable matcher: keeps the matched prefix length across feed() calls and reports global offsets,
+     * so a text can be scanned chunk by chunk with O(pattern) memory.
+     *
+     * @note The Kmp must outlive the stream.
+     */
+    class Stream
+    {
+    public:
+
+        using offset_type = int64;
+
+        explicit
+        Stream(const Kmp& __kmp) noexcept
+            : _M_kmp(&__kmp)
+        { }
+
+        /**
+         * @brief Writes the global start of every occurrence ending inside @p __chunk, including ones that began in
+         * earlier chunks.
+         */
+        template<std::output_iterator<offset_type> _Out>
+        _Out
+        feed(std::string_view __chunk, _Out __result)
+        {
+            const size_type m = _M_kmp->size();
+            const offset_type base = _M_offset;
+
+            _M_offset += offset_type(__chunk.size());
+
+            if (m == 0)
+            {
+                // _M_state marks whether position 0 has been reported already.
+                for (offset_type p = base + (_M_state != 0); p <= _M_offset; ++p)
+                {
+                    *__result = p;
+                    ++__result;
+                }
+
+                _M_state = 1;
+                return __result;
+            }
+
+            const char* pattern = _M_kmp->_M_pattern.data();
+            const size_type* lps = _M_kmp->_M_lps.data();
+
+            size_type c = _M_state;
+
+            for (std::size_t i = 0; i < __chunk.size(); ++i)
+            {
+                if (c == 0 and (i = _M_kmp->_M_candidate(__chunk, i)) == __chunk.size())
+                {
+                    break;
+                }
+
+                while (c > 0 and __chunk[i] != pattern[c])
+                {
+                    c = lps[c - 1];
+                }
+
+                if (__chunk[i] == pattern[c])
+                {
+                    ++c;
+                }
+
+                if (c == m)
+                {
+                    *__result = base + offset_type(i) + 1 - m;
+                    ++__result;
+                    c = lps[c - 1];
+                }
+            }
+
+            _M_state = c;
+            return __result;
+        }
+
+        /**
+         * @returns number of characters fed so far
+         */
+        [[nodiscard]] offset_type
+        offset() const noexcept
+        { return _M_offset; }
+
+        /**
+         * @returns length of the pattern prefix matching the end of the input so far
+         */
+        [[nodiscard]] size_type
+        state() const noexcept
+        { return _M_kmp->empty() ? 0 : _M_state; }
+
+        void
+        reset() noexcept
+        { _M_offset = 0, _M_state = 0; }
+
+    private:
+
+        const Kmp* _M_kmp;
+
+        offset_type _M_offset = 0;
+        size_type _M_state = 0;
+    };
+
     Kmp() noexcept = default;
 
     Kmp(std::string __pattern)
@@ -43,6 +156,11 @@ public:
 
         for (size_type i = 0, c = 0; i < size_type(__s.size()); ++i)
         {
+            if (c == 0 and (i = static_cast<size_type>(_M_candidate(__s, i))) == size_type(__s.size()))
+            {
+                break;
+            }
+
             while (c > 0 and __s[i] != _M_pattern[c])
             {
                 c = _M_lps[c - 1];
@@ -73,6 +191,11 @@ public:
 
         for (size_type i = 0, c = 0; i < size_type(__s.size()); ++i)
         {
+            if (c == 0 and (i = static_cast<size_type>(_M_candidate(__s, i))) == size_type(__s.size()))
+            {
+                break;
+            }
+
             while (c > 0 and __s[i] != _M_pattern[c])
             {
                 c = _M_lps[c - 1];
@@ -110,6 +233,11 @@ public:
 
         for (size_type i = 0, c = 0; i < size_type(__s.size()); ++i)
         {
+            if (c == 0 and (i = static_cast<size_type>(_M_candidate(__s, i))) == size_type(__s.size()))
+            {
+                break;
+            }
+
             while (c > 0 and __s[i] != _M_pattern[c])
             {
                 c = _M_lps[c - 1];
@@ -133,6 +261,10 @@ public:
     contains(std::string_view __s) const
     { return find(__s) != npos; }
 
+    [[nodiscard]] Stream
+    stream() const noexcept
+    { return Stream(*this); }
+
     [[nodiscard]] size_type
     count_matches(std::string_view __s) const
     {
@@ -145,6 +277,11 @@ public:
 
         for (size_type i = 0, c = 0; i < size_type(__s.size()); ++i)
         {
+            if (c == 0 and (i = static_cast<size_type>(_M_candidate(__s, i))) == size_type(__s.size()))
+            {
+                break;
+            }
+
             while (c > 0 and __s[i] != _M_pattern[c])
             {
                 c = _M_lps[c - 1];
@@ -167,6 +304,76 @@ public:
 
 private:
 
+    /**
+     * @returns first j >= @p __i where an occurrence can start: the first pattern byte followed by the second one,
+     * or by the end of @p __s (a match may continue in the next chunk), or the size of @p __s if there is none
+     *
+     * @note The pattern must not be empty.
+     */
+    [[nodiscard]] std::size_t
+    _M_candidate(std::string_view __s, std::size_t __i) const noexcept
+    {
+        const char* s = __s.data();
+        const std::size_t n = __s.size();
+
+        if (__i >= n)
+        {
+            return n;
+        }
+
+        if (size() == 1)
+        {
+            const void* p = std::memchr(s + __i, _M_pattern[0], n - __i);
+            return p ? static_cast<std::size_t>(static_cast<const char*>(p) - s) : n;
+        }
+
+        const char c0 = _M_pattern[0], c1 = _M_pattern[1];
+
+        // Dense texts resume right at a candidate, so check it before paying for a vector load.
+        if (s[__i] == c0 and (__i + 1 == n or s[__i + 1] == c1))
+        {
+            return __i;
+        }
+
+#if defined(__AVX2__)
+        const __m256i v0 = _mm256_set1_epi8(c0), v1 = _mm256_set1_epi8(c1);
+
+        for (; __i + 33 <= n; __i += 32)
+        {
+            const __m256i e0 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + __i)), v0);
+            const __m256i e1 = _mm256_cmpeq_epi8(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(s + __i + 1)), v1);
+
+            if (const uint32 mask = static_cast<uint32>(_mm256_movemask_epi8(_mm256_and_si256(e0, e1))); mask != 0)
+            {
+                return __i + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+#elif defined(__SSE2__)
+        const __m128i v0 = _mm_set1_epi8(c0), v1 = _mm_set1_epi8(c1);
+
+        for (; __i + 17 <= n; __i += 16)
+        {
+            const __m128i e0 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + __i)), v0);
+            const __m128i e1 = _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(s + __i + 1)), v1);
+
+            if (const uint32 mask = static_cast<uint32>(_mm_movemask_epi8(_mm_and_si128(e0, e1))); mask != 0)
+            {
+                return __i + static_cast<std::size_t>(std::countr_zero(mask));
+            }
+        }
+#endif
+
+        for (; __i + 1 < n; ++__i)
+        {
+            if (s[__i] == c0 and s[__i + 1] == c1)
+            {
+                return __i;
+            }
+        }
+
+        return s[n - 1] == c0 ? n - 1 : n;
+    }
+
     void
     _M_build()
     {
@@ -0,0 +1,129 @@
+#if __has_include(<sys/mman.h>)
+/**
+ * @brief Read-only file scanned through page-aligned mmap windows, for feeding streaming matchers
+ * (Kmp::Stream, AhoCorasick::Stream) with files larger than memory.
+ *
+ * Only one window is mapped at a time and it is unmapped before the next one, so resident memory stays around the
+ * window size whatever the file size.
+ *
+ * @note POSIX only: defined only where <sys/mman.h> exists, with the headers from the contest template prelude.
+ * Errors are thrown as std::system_error.
+ */
+class MappedFile
+{
+public:
+
+    using size_type = std::size_t;
+
+    static constexpr size_type default_window = size_type(1) << 24;
+
+    explicit
+    MappedFile(const char* __path)
+        : _M_fd(::open(__path, O_RDONLY))
+    {
+        if (_M_fd < 0)
+        {
+            throw std::system_error(errno, std::generic_category(), "MappedFile::open");
+        }
+
+        struct stat st;
+
+        if (::fstat(_M_fd, &st) != 0)
+        {
+            const int err = errno;
+            ::close(_M_fd);
+
+            throw std::system_error(err, std::generic_category(), "MappedFile::fstat");
+        }
+
+        _M_size = static_cast<size_type>(st.st_size);
+    }
+
+    MappedFile(const MappedFile&) = delete;
+
+    MappedFile&
+    operator=(const MappedFile&) = delete;
+
+    MappedFile(MappedFile&& __other) noexcept
+        : _M_fd(std::exchange(__other._M_fd, -1)), _M_size(std::exchange(__other._M_size, 0))
+    { }
+
+    MappedFile&
+    operator=(MappedFile&& __other) noexcept
+    {
+        std::swap(_M_fd, __other._M_fd);
+        std::swap(_M_size, __other._M_size);
+        return *this;
+    }
+
+    ~MappedFile()
+    {
+        if (_M_fd >= 0)
+        {
+            ::close(_M_fd);
+        }
+    }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return _M_size; }
+
+    /**
+     * @brief Calls @p __f with consecutive std::string_view chunks covering the file, each at most @p __window bytes
+     * (rounded up to whole pages) and starting at a page-aligned offset.
+     */
+    template<std::invocable<std::string_view> _Func>
+    void
+    for_each_chunk(_Func __f, size_type __window = default_window) const
+    {
+        const size_type page = static_cast<size_type>(::sysconf(_SC_PAGESIZE));
+        __window = std::max(page, (__window + page - 1) / page * page);
+
+        for (size_type off = 0; off < _M_size; off += __window)
+        {
+            const size_type len = std::min(__window, _M_size - off);
+            void* p = ::mmap(nullptr, len, PROT_READ, MAP_PRIVATE, _M_fd, static_cast<off_t>(off));
+
+            if (p == MAP_FAILED)
+            {
+                throw std::system_error(errno, std::generic_category(), "MappedFile::mmap");
+            }
+
+            // Unmaps even if __f throws.
+            const std::unique_ptr<void, _Unmap> guard(p, _Unmap{len});
+
+            ::madvise(p, len, MADV_SEQUENTIAL);
+            __f(std::string_view(static_cast<const char*>(p), len));
+        }
+    }
+
+    /**
+     * @brief Feeds the whole file to @p __stream.
+     *
+     * @returns @p __result after every match was written
+     */
+    template<typename _Stream, typename _Out>
+    _Out
+    feed(_Stream& __stream, _Out __result, size_type __window = default_window) const
+    {
+        for_each_chunk([&](std::string_view chunk) -> void { __result = __stream.feed(chunk, std::move(__result)); },
+                       __window);
+
+        return __result;
+    }
+
+private:
+
+    struct _Unmap
+    {
+        size_type len;
+
+        void
+        operator()(void* __p) const noexcept
+        { ::munmap(__p, len); }
+    };
+
+    int _M_fd;
+    size_type _M_size = 0;
+};
+#endif
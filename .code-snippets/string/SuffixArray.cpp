@@ -0,0 +1,477 @@
+/**
+ * @brief Suffix array by SA-IS in O(n + alphabet), Kasai's LCP array, and LCP of any two suffixes in O(1).
+ *
+ * Values may be any integers. A value range up to about n is used as is, anything wider is compressed first.
+ * LCP queries run on a sparse table over blocks of 32 plus one in-block stack bitmask per position, so the whole
+ * structure stays around 4n words (sa, rank, lcp, masks) instead of the n log n of a plain sparse table.
+ */
+class SuffixArray
+{
+public:
+
+    using size_type = int;
+
+    SuffixArray() = default;
+
+    template<
+        std::random_access_iterator _Iter,
+        std::sized_sentinel_for<_Iter> _Sent,
+        typename _Proj = std::identity>
+    requires
+        std::integral<std::remove_cvref_t<std::indirect_result_t<_Proj&, _Iter>>>
+    SuffixArray(_Iter __first, _Sent __last, _Proj __proj = {})
+    { build(__first, __last, __proj); }
+
+    template<
+        std::ranges::random_access_range _Range,
+        typename _Proj = std::identity>
+    SuffixArray(_Range&& __r, _Proj __proj = {})
+    { build(std::forward<_Range>(__r), __proj); }
+
+    template<
+        std::random_access_iterator _Iter,
+        std::sized_sentinel_for<_Iter> _Sent,
+        typename _Proj = std::identity>
+    requires
+        std::integral<std::remove_cvref_t<std::indirect_result_t<_Proj&, _Iter>>>
+    void
+    build(_Iter __first, _Sent __last, _Proj __proj = {})
+    {
+        const size_type n = static_cast<size_type>(std::ranges::distance(__first, __last));
+
+        std::vector<size_type> s(n);
+        const size_type upper = _S_normalize(__first, n, __proj, s);
+
+        _M_sa = _S_sa_is(s, upper);
+
+        _M_rank.resize(n);
+
+        for (size_type k = 0; k < n; ++k)
+        {
+            _M_rank[_M_sa[k]] = k;
+        }
+
+        _M_kasai(s);
+
+        s.clear();
+        s.shrink_to_fit();
+
+        _M_build_rmq();
+    }
+
+    template<
+        std::ranges::random_access_range _Range,
+        typename _Proj = std::identity>
+    void
+    build(_Range&& __r, _Proj __proj = {})
+    { build(std::ranges::begin(__r), std::ranges::end(__r), __proj); }
+
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return static_cast<size_type>(_M_sa.size()); }
+
+    [[nodiscard]] bool
+    empty() const noexcept
+    { return _M_sa.empty(); }
+
+    /**
+     * @returns start of the @p __k-th smallest suffix
+     */
+    [[nodiscard]] size_type
+    operator[](size_type __k) const
+    { return _M_sa[__k]; }
+
+    [[nodiscard]] std::span<const size_type>
+    sa() const noexcept
+    { return _M_sa; }
+
+    /**
+     * @returns position of the suffix starting at @p __i in sorted order
+     */
+    [[nodiscard]] size_type
+    rank(size_type __i) const
+    { return _M_rank[__i]; }
+
+    /**
+     * @returns lcp_array()[k] = LCP of the suffixes sa[k] and sa[k + 1], size n - 1
+     */
+    [[nodiscard]] std::span<const size_type>
+    lcp_array() const noexcept
+    { return _M_lcp; }
+
+    /**
+     * @returns LCP of the suffixes starting at @p __i and @p __j, O(1)
+     */
+    [[nodiscard]] size_type
+    lcp(size_type __i, size_type __j) const
+    {
+        if (__i == __j)
+        {
+            return size() - __i;
+        }
+
+        auto [l, r] = std::minmax(_M_rank[__i], _M_rank[__j]);
+        return _M_range_min(l, r - 1);
+    }
+
+    /**
+     * @brief Compares [i, i + n1) with [j, j + n2), O(1).
+     */
+    [[nodiscard]] std::strong_ordering
+    compare(size_type __i, size_type __n1, size_type __j, size_type __n2) const
+    {
+        if (lcp(__i, __j) >= std::min(__n1, __n2))
+        {
+            return __n1 <=> __n2;
+        }
+
+        return _M_rank[__i] <=> _M_rank[__j];
+    }
+
+    void
+    clear() noexcept
+    {
+        _M_sa.clear();
+        _M_rank.clear();
+        _M_lcp.clear();
+        _M_mask.clear();
+        _M_table.clear();
+    }
+
+private:
+
+    static constexpr size_type _S_block = 32;
+
+    /**
+     * @brief Maps the values to [0, upper] in order, shifting small ranges and compressing wide ones.
+     *
+     * @returns upper
+     */
+    template<typename _Iter, typename _Proj>
+    static size_type
+    _S_normalize(_Iter __first, size_type __n, _Proj& __proj, std::vector<size_type>& __s)
+    {
+        if (__n == 0)
+        {
+            return 0;
+        }
+
+        using value_type = std::remove_cvref_t<std::indirect_result_t<_Proj&, _Iter>>;
+
+        value_type lo = std::invoke(__proj, __first[0]), hi = lo;
+
+        for (size_type i = 1; i < __n; ++i)
+        {
+            const value_type v = std::invoke(__proj, __first[i]);
+
+            lo = std::min(lo, v);
+            hi = std::max(hi, v);
+        }
+
+        // Differences are taken mod 2^64, which is exact for hi >= lo whatever the signedness.
+        if (const uint64 range = static_cast<uint64>(hi) - static_cast<uint64>(lo); range <= static_cast<uint64>(std::max(__n, 256)))
+        {
+            for (size_type i = 0; i < __n; ++i)
+            {
+                __s[i] = static_cast<size_type>(static_cast<uint64>(std::invoke(__proj, __first[i])) - static_cast<uint64>(lo));
+            }
+
+            return static_cast<size_type>(range);
+        }
+
+        std::vector<value_type> values(__n);
+
+        for (size_type i = 0; i < __n; ++i)
+        {
+            values[i] = std::invoke(__proj, __first[i]);
+        }
+
+        std::ranges::sort(values);
+        values.erase(std::ranges::unique(values).begin(), values.end());
+
+        for (size_type i = 0; i < __n; ++i)
+        {
+            __s[i] = static_cast<size_type>(std::ranges::lower_bound(values, std::invoke(__proj, __first[i])) - values.begin());
+        }
+
+        return static_cast<size_type>(values.size()) - 1;
+    }
+
+    /**
+     * @brief SA-IS (Nong, Zhang, Chan) on values in [0, @p __upper].
+     */
+    static std::vector<size_type>
+    _S_sa_is(const std::vector<size_type>& __s, size_type __upper)
+    {
+        const size_type n = static_cast<size_type>(__s.size());
+
+        if (n <= 2)
+        {
+            if (n == 2 and __s[0] >= __s[1])
+            {
+                return {1, 0};
+            }
+
+            std::vector<size_type> sa(n);
+            std::iota(sa.begin(), sa.end(), 0);
+
+            return sa;
+        }
+
+        std::vector<size_type> sa(n);
+
+        // is_s[i]: suffix i is smaller than suffix i + 1 (S-type), the last suffix counts as L-type
+        std::vector<bool> is_s(n);
+
+        for (size_type i = n - 2; i >= 0; --i)
+        {
+            is_s[i] = __s[i] == __s[i + 1] ? is_s[i + 1] : __s[i] < __s[i + 1];
+        }
+
+        // Bucket c holds L-type suffixes at [sum_l[c], sum_s[c]) and S-type ones at [sum_s[c], sum_l[c + 1]).
+        std::vector<size_type> sum_l(__upper + 2), sum_s(__upper + 2);
+
+        for (size_type i = 0; i < n; ++i)
+        {
+            if (is_s[i])
+            {
+                ++sum_l[__s[i] + 1];
+            }
+            else
+            {
+                ++sum_s[__s[i]];
+            }
+        }
+
+        for (size_type c = 0; c <= __upper; ++c)
+        {
+            sum_s[c] += sum_l[c];
+            sum_l[c + 1] += sum_s[c];
+        }
+
+        std::vector<size_type> buf(__upper + 2);
+
+        const auto induce = [&](const std::vector<size_type>& __lms) -> void
+        {
+            std::ranges::fill(sa, -1);
+
+            std::ranges::copy(sum_s, buf.begin());
+
+            for (const size_type d : __lms)
+            {
+                sa[buf[__s[d]]++] = d;
+            }
+
+            std::ranges::copy(sum_l, buf.begin());
+            sa[buf[__s[n - 1]]++] = n - 1;
+
+            for (size_type k = 0; k < n; ++k)
+            {
+                if (const size_type v = sa[k]; v >= 1 and not is_s[v - 1])
+                {
+                    sa[buf[__s[v - 1]]++] = v - 1;
+                }
+            }
+
+            std::ranges::copy(sum_l, buf.begin());
+
+            for (size_type k = n - 1; k >= 0; --k)
+            {
+                if (const size_type v = sa[k]; v >= 1 and is_s[v - 1])
+                {
+                    sa[--buf[__s[v - 1] + 1]] = v - 1;
+                }
+            }
+        };
+
+        // LMS positions, and each one's index among them
+        std::vector<size_type> lms;
+        std::vector<size_type> lms_index(n, -1);
+
+        for (size_type i = 1; i < n; ++i)
+        {
+            if (not is_s[i - 1] and is_s[i])
+            {
+                lms_index[i] = static_cast<size_type>(lms.size());
+                lms.push_back(i);
+            }
+        }
+
+        const size_type m = static_cast<size_type>(lms.size());
+
+        induce(lms);
+
+        if (m == 0)
+        {
+            return sa;
+        }
+
+        // Name the LMS substrings in sorted order, equal substrings share a name.
+        std::vector<size_type> sorted_lms;
+        sorted_lms.reserve(m);
+
+        for (const size_type v : sa)
+        {
+            if (lms_index[v] != -1)
+            {
+                sorted_lms.push_back(v);
+            }
+        }
+
+        std::vector<size_type> rec(m);
+        size_type rec_upper = 0;
+
+        for (size_type k = 1; k < m; ++k)
+        {
+            size_type l = sorted_lms[k - 1], r = sorted_lms[k];
+
+            const size_type end_l = lms_index[l] + 1 < m ? lms[lms_index[l] + 1] : n;
+            const size_type end_r = lms_index[r] + 1 < m ? lms[lms_index[r] + 1] : n;
+
+            bool same = end_l - l == end_r - r;
+
+            if (same)
+            {
+                for (; l < end_l and __s[l] == __s[r]; ++l, ++r);
+
+                same = l != n and __s[l] == __s[r];
+            }
+
+            rec_upper += not same;
+            rec[lms_index[sorted_lms[k]]] = rec_upper;
+        }
+
+        lms_index.clear();
+        lms_index.shrink_to_fit();
+
+        const std::vector<size_type> rec_sa = _S_sa_is(rec, rec_upper);
+
+        for (size_type k = 0; k < m; ++k)
+        {
+            sorted_lms[k] = lms[rec_sa[k]];
+        }
+
+        induce(sorted_lms);
+        return sa;
+    }
+
+    void
+    _M_kasai(const std::vector<size_type>& __s)
+    {
+        const size_type n = size();
+
+        _M_lcp.assign(std::max(n - 1, 0), 0);
+
+        for (size_type i = 0, h = 0; i < n; ++i)
+        {
+            if (h > 0)
+            {
+                --h;
+            }
+
+            if (_M_rank[i] == 0)
+            {
+                h = 0;
+                continue;
+            }
+
+            const size_type j = _M_sa[_M_rank[i] - 1];
+
+            for (; i + h < n and j + h < n and __s[i + h] == __s[j + h]; ++h);
+
+            _M_lcp[_M_rank[i] - 1] = h;
+        }
+    }
+
+    /**
+     * @brief For position i, bit k of _M_mask[i] is set when block offset k is still on the min-stack of its block
+     * after pushing i, so the minimum of [l, i] inside one block is at the lowest such bit >= l.
+     */
+    void
+    _M_build_rmq()
+    {
+        const size_type n = static_cast<size_type>(_M_lcp.size());
+        const size_type blocks = (n + _S_block - 1) / _S_block;
+
+        _M_mask.assign(n, 0);
+
+        for (size_type b = 0; b < blocks; ++b)
+        {
+            uint32 stack = 0;
+
+            for (size_type i = b * _S_block; i < std::min(n, (b + 1) * _S_block); ++i)
+            {
+                while (stack and _M_lcp[b * _S_block + std::bit_width(stack) - 1] >= _M_lcp[i])
+                {
+                    stack ^= uint32{1} << (std::bit_width(stack) - 1);
+                }
+
+                _M_mask[i] = stack |= uint32{1} << (i % _S_block);
+            }
+        }
+
+        _M_table.assign(std::bit_width(static_cast<uint32>(blocks)), {});
+
+        if (blocks == 0)
+        {
+            return;
+        }
+
+        _M_table[0].resize(blocks);
+
+        for (size_type b = 0; b < blocks; ++b)
+        {
+            _M_table[0][b] = _M_in_block(b * _S_block, std::min(n, (b + 1) * _S_block) - 1);
+        }
+
+        for (size_type k = 1; k < size_type(_M_table.size()); ++k)
+        {
+            _M_table[k].resize(blocks - (1 << k) + 1);
+
+            for (size_type b = 0; b + (1 << k) <= blocks; ++b)
+            {
+                _M_table[k][b] = std::min(_M_table[k - 1][b], _M_table[k - 1][b + (1 << (k - 1))]);
+            }
+        }
+    }
+
+    /**
+     * @returns min of _M_lcp[l, r], both in the same block
+     */
+    [[nodiscard]] size_type
+    _M_in_block(size_type __l, size_type __r) const
+    { return _M_lcp[(__r & -_S_block) + std::countr_zero(_M_mask[__r] & (~uint32{} << (__l % _S_block)))]; }
+
+    /**
+     * @returns min of _M_lcp[l, r]
+     */
+    [[nodiscard]] size_type
+    _M_range_min(size_type __l, size_type __r) const
+    {
+        const size_type bl = __l / _S_block, br = __r / _S_block;
+
+        if (bl == br)
+        {
+            return _M_in_block(__l, __r);
+        }
+
+        size_type res = std::min(_M_in_block(__l, (bl + 1) * _S_block - 1), _M_in_block(br * _S_block, __r));
+
+        if (bl + 1 < br)
+        {
+            const size_type k = std::bit_width(static_cast<uint32>(br - bl - 1)) - 1;
+            res = std::min({res, _M_table[k][bl + 1], _M_table[k][br - (1 << k)]});
+        }
+
+        return res;
+    }
+
+    std::vector<size_type> _M_sa;
+    std::vector<size_type> _M_rank;
+    std::vector<size_type> _M_lcp;
+
+    std::vector<uint32> _M_mask;
+
+    // _M_table[k][b] = min of the block minima over blocks [b, b + 2^k)
+    std::vector<std::vector<size_type>> _M_table;
+};
@@ -0,0 +1,523 @@
+/**
+ * @brief Transition storage for SuffixAutomaton.
+ *
+ * Each policy holds the transitions of every state: @c add_state / @c add_state_copy append one, @c get returns
+ * the target or 0 (the root is never a target), @c set adds or redirects one, @c for_each visits them by key.
+ */
+struct SuffixAutomatonPolicy
+{
+    /**
+     * @brief One array of @p _Sigma targets per state, keys in [_First, _First + _Sigma). O(1) transitions.
+     */
+    template<int _Sigma = 26, int _First = 'a'>
+    class Dense
+    {
+    public:
+
+        using size_type = int;
+
+        void
+        reserve(size_type __states)
+        { _M_next.reserve(__states); }
+
+        void
+        clear() noexcept
+        { _M_next.clear(); }
+
+        void
+        add_state()
+        { _M_next.emplace_back(); }
+
+        void
+        add_state_copy(size_type __src)
+        {
+            const auto row = _M_next[__src];
+            _M_next.push_back(row);
+        }
+
+        [[nodiscard]] size_type
+        get(size_type __u, int __key) const
+        { return _M_next[__u][__key - _First]; }
+
+        void
+        set(size_type __u, int __key, size_type __v)
+        { _M_next[__u][__key - _First] = __v; }
+
+        template<typename _Func>
+        void
+        for_each(size_type __u, _Func __f) const
+        {
+            for (int k = 0; k < _Sigma; ++k)
+            {
+                if (const size_type v = _M_next[__u][k])
+                {
+                    __f(k + _First, v);
+                }
+            }
+        }
+
+    private:
+
+        std::vector<std::array<size_type, _Sigma>> _M_next;
+    };
+
+    /**
+     * @brief Per-state edge arrays kept sorted by key, all in one arena. O(out-degree) transitions on one or two
+     * cache lines, any int key, 8 bytes per edge.
+     *
+     * A state's block holds bit_ceil(degree) edges; a full block moves to the end of the arena at twice the size and
+     * its old slots are left unused, which costs at most as much as the edges themselves.
+     */
+    class Sorted
+    {
+    public:
+
+        using size_type = int;
+
+        void
+        reserve(size_type __states)
+        {
+            _M_off.reserve(__states);
+            _M_deg.reserve(__states);
+            _M_edges.reserve(__states * 2);
+        }
+
+        void
+        clear() noexcept
+        {
+            _M_off.clear();
+            _M_deg.clear();
+            _M_edges.clear();
+        }
+
+        void
+        add_state()
+        {
+            _M_off.push_back(0);
+            _M_deg.push_back(0);
+        }
+
+        void
+        add_state_copy(size_type __src)
+        {
+            const size_type off = static_cast<size_type>(_M_edges.size()), deg = _M_deg[__src];
+
+            _M_edges.resize(off + std::bit_ceil(static_cast<uint32>(deg)));
+            std::copy_n(_M_edges.begin() + _M_off[__src], deg, _M_edges.begin() + off);
+
+            _M_off.push_back(off);
+            _M_deg.push_back(deg);
+        }
+
+        [[nodiscard]] size_type
+        get(size_type __u, int __key) const
+        {
+            const edge* e = _M_edges.data() + _M_off[__u];
+
+            for (size_type i = 0; i < _M_deg[__u] and e[i].key <= __key; ++i)
+            {
+                if (e[i].key == __key)
+                {
+                    return e[i].to;
+                }
+            }
+
+            return 0;
+        }
+
+        void
+        set(size_type __u, int __key, size_type __v)
+        {
+            size_type deg = _M_deg[__u], i = 0;
+
+            for (edge* e = _M_edges.data() + _M_off[__u]; i < deg and e[i].key < __key; ++i);
+
+            if (i < deg and _M_edges[_M_off[__u] + i].key == __key)
+            {
+                _M_edges[_M_off[__u] + i].to = __v;
+                return;
+            }
+
+            // Degrees 0, 1, 2, 4, ... fill their block exactly.
+            if (std::has_single_bit(static_cast<uint32>(deg)) or deg == 0)
+            {
+                const size_type off = static_cast<size_type>(_M_edges.size());
+
+                _M_edges.resize(off + std::max(deg * 2, 1));
+                std::copy_n(_M_edges.begin() + _M_off[__u], deg, _M_edges.begin() + off);
+
+                _M_off[__u] = off;
+            }
+
+            edge* e = _M_edges.data() + _M_off[__u];
+
+            std::copy_backward(e + i, e + deg, e + deg + 1);
+            e[i] = {__key, __v};
+
+            ++_M_deg[__u];
+        }
+
+        template<typename _Func>
+        void
+        for_each(size_type __u, _Func __f) const
+        {
+            for (size_type i = 0; i < _M_deg[__u]; ++i)
+            {
+                __f(_M_edges[_M_off[__u] + i].key, _M_edges[_M_off[__u] + i].to);
+            }
+        }
+
+    private:
+
+        struct edge
+        {
+            int key;
+            size_type to;
+        };
+
+        std::vector<size_type> _M_off;
+        std::vector<size_type> _M_deg;
+
+        std::vector<edge> _M_edges;
+    };
+};
+
+/**
+ * @brief Suffix automaton, online and generalized: every add_string() adds all substrings of one more string.
+ *
+ * State 0 is the root. Occurrence counts (|endpos|) are computed on demand in one pass over the states in
+ * topological (length) order and reused until the next extension.
+ */
+template<typename _Transitions = SuffixAutomatonPolicy::Dense<>>
+class SuffixAutomaton
+{
+public:
+
+    using size_type = int;
+    using transitions_type = _Transitions;
+
+    static constexpr size_type npos = -1;
+
+    SuffixAutomaton()
+    { clear(); }
+
+    template<std::ranges::input_range _Range>
+    SuffixAutomaton(_Range&& __r)
+        : SuffixAutomaton()
+    {
+        if constexpr (std::ranges::sized_range<_Range>)
+        {
+            _M_reserve(2 * static_cast<size_type>(std::ranges::size(__r)));
+        }
+
+        add_string(std::forward<_Range>(__r));
+    }
+
+    /**
+     * @brief Appends @p __c to the current string.
+     */
+    void
+    extend(int __c)
+    {
+        _M_counted = false;
+
+        if (const size_type q = _M_next.get(_M_last, __c))
+        {
+            // Generalized: this prefix is already a substring of an earlier string.
+            _M_last = _M_len[q] == _M_len[_M_last] + 1 ? q : _M_clone(_M_last, q, __c);
+            ++_M_own[_M_last];
+
+            return;
+        }
+
+        const size_type cur = _M_add_state(_M_len[_M_last] + 1, 1);
+        size_type p = _M_last;
+
+        for (; p != npos and not _M_next.get(p, __c); p = _M_link[p])
+        {
+            _M_next.set(p, __c, cur);
+        }
+
+        if (p == npos)
+        {
+            _M_link[cur] = 0;
+        }
+        else if (const size_type q = _M_next.get(p, __c); _M_len[q] == _M_len[p] + 1)
+        {
+            _M_link[cur] = q;
+        }
+        else
+        {
+            _M_link[cur] = _M_clone(p, q, __c);
+        }
+
+        _M_last = cur;
+    }
+
+    /**
+     * @brief Adds another string, starting again from the root.
+     */
+    template<std::ranges::input_range _Range>
+    void
+    add_string(_Range&& __r)
+    {
+        _M_last = 0;
+
+        for (const auto& c : __r)
+        {
+            extend(static_cast<int>(c));
+        }
+    }
+
+    /**
+     * @returns number of states
+     */
+    [[nodiscard]] size_type
+    size() const noexcept
+    { return static_cast<size_type>(_M_len.size()); }
+
+    [[nodiscard]] bool
+    empty() const noexcept
+    { return size() == 1; }
+
+    void
+    clear()
+    {
+        _M_len.clear();
+        _M_link.clear();
+        _M_own.clear();
+        _M_next.clear();
+
+        _M_add_state(0, 0);
+        _M_link[0] = npos;
+        _M_last = 0;
+        _M_counted = false;
+    }
+
+    /**
+     * @returns length of the longest substring in state @p __v
+     */
+    [[nodiscard]] size_type
+    len(size_type __v) const
+    { return _M_len[__v]; }
+
+    /**
+     * @returns suffix link of @p __v, npos for the root
+     */
+    [[nodiscard]] size_type
+    link(size_type __v) const
+    { return _M_link[__v]; }
+
+    /**
+     * @returns transition of @p __v by @p __c, or 0 if there is none
+     */
+    [[nodiscard]] size_type
+    next(size_type __v, int __c) const
+    { return _M_next.get(__v, __c); }
+
+    [[nodiscard]] const transitions_type&
+    transitions() const noexcept
+    { return _M_next; }
+
+    /**
+     * @returns state reached by reading @p __r from the root, or npos if it is not a substring
+     */
+    template<std::ranges::input_range _Range>
+    [[nodiscard]] size_type
+    find(_Range&& __r) const
+    {
+        size_type v = 0;
+
+        for (const auto& c : __r)
+        {
+            if (not (v = _M_next.get(v, static_cast<int>(c))))
+            {
+                return npos;
+            }
+        }
+
+        return v;
+    }
+
+    template<std::ranges::input_range _Range>
+    [[nodiscard]] bool
+    contains(_Range&& __r) const
+    { return find(std::forward<_Range>(__r)) != npos; }
+
+    /**
+     * @returns number of distinct non-empty substrings
+     */
+    template<typename _Result = long long>
+    [[nodiscard]] _Result
+    count() const noexcept
+    {
+        _Result res{};
+
+        for (size_type v = 1; v < size(); ++v)
+        {
+            res += _M_len[v] - _M_len[_M_link[v]];
+        }
+
+        return res;
+    }
+
+    /**
+     * @returns |endpos(v)|, i.e. how many times each substring of @p __v occurs over all added strings
+     */
+    [[nodiscard]] size_type
+    endpos_size(size_type __v)
+    {
+        _M_count();
+        return _M_cnt[__v];
+    }
+
+    /**
+     * @returns number of occurrences of @p __r, overlapping ones included
+     */
+    template<std::ranges::input_range _Range>
+    [[nodiscard]] size_type
+    occurrences(_Range&& __r)
+    {
+        const size_type v = find(std::forward<_Range>(__r));
+        return v == npos ? 0 : endpos_size(v);
+    }
+
+    /**
+     * @returns states sorted by len(), so every suffix link points backwards
+     */
+    [[nodiscard]] std::span<const size_type>
+    topological_order()
+    {
+        _M_count();
+        return _M_order;
+    }
+
+    /**
+     * @returns [start, length] in @p __r of its longest substring that is also a substring here
+     */
+    template<std::ranges::input_range _Range>
+    [[nodiscard]] std::pair<size_type, size_type>
+    longest_common_substring(_Range&& __r) const
+    {
+        size_type v = 0, l = 0, i = 0;
+        std::pair<size_type, size_type> best{};
+
+        for (const auto& ch : __r)
+        {
+            const int c = static_cast<int>(ch);
+
+            for (; v and not _M_next.get(v, c); v = _M_link[v], l = _M_len[v]);
+
+            if (const size_type u = _M_next.get(v, c))
+            {
+                v = u;
+                ++l;
+            }
+
+            if (++i, l > best.second)
+            {
+                best = {i - l, l};
+            }
+        }
+
+        return best;
+    }
+
+private:
+
+    void
+    _M_reserve(size_type __states)
+    {
+        _M_len.reserve(__states);
+        _M_link.reserve(__states);
+        _M_own.reserve(__states);
+        _M_next.reserve(__states);
+    }
+
+    size_type
+    _M_add_state(size_type __len, size_type __own)
+    {
+        _M_len.push_back(__len);
+        _M_link.push_back(0);
+        _M_own.push_back(__own);
+        _M_next.add_state();
+
+        return size() - 1;
+    }
+
+    /**
+     * @brief Splits @p __q, entered from @p __p by @p __c, so that the part of length len(p) + 1 gets its own state.
+     */
+    size_type
+    _M_clone(size_type __p, size_type __q, int __c)
+    {
+        const size_type clone = size();
+
+        _M_len.push_back(_M_len[__p] + 1);
+        _M_link.push_back(_M_link[__q]);
+        _M_own.push_back(0);
+        _M_next.add_state_copy(__q);
+
+        for (; __p != npos and _M_next.get(__p, __c) == __q; __p = _M_link[__p])
+        {
+            _M_next.set(__p, __c, clone);
+        }
+
+        _M_link[__q] = clone;
+        return clone;
+    }
+
+    /**
+     * @brief Counting sort by len, then endpos sizes pushed up the suffix links.
+     */
+    void
+    _M_count()
+    {
+        if (_M_counted)
+        {
+            return;
+        }
+
+        const size_type n = size();
+        std::vector<size_type> bucket(_M_len.empty() ? 1 : std::ranges::max(_M_len) + 2);
+
+        for (const size_type l : _M_len)
+        {
+            ++bucket[l + 1];
+        }
+
+        std::partial_sum(bucket.begin(), bucket.end(), bucket.begin());
+
+        _M_order.resize(n);
+
+        for (size_type v = 0; v < n; ++v)
+        {
+            _M_order[bucket[_M_len[v]]++] = v;
+        }
+
+        _M_cnt = _M_own;
+
+        for (size_type k = n - 1; k > 0; --k)
+        {
+            const size_type v = _M_order[k];
+            _M_cnt[_M_link[v]] += _M_cnt[v];
+        }
+
+        _M_counted = true;
+    }
+
+    std::vector<size_type> _M_len;
+    std::vector<size_type> _M_link;
+
+    // prefix ends landing exactly on the state, i.e. its own contribution to |endpos|
+    std::vector<size_type> _M_own;
+
+    transitions_type _M_next;
+
+    size_type _M_last = 0;
+
+    bool _M_counted = false;
+
+    std::vector<size_type> _M_order;
+    std::vector<size_type> _M_cnt;
+};